@@ -19,6 +19,7 @@
 
 // Analytics Bridge
 #import "NativeModules/Analytics/AnalyticsManagerBridge.h"
+#import "NativeModules/Analytics/AnalyticsAtomics.h"
 
 // Error Code Constants
 extern NSInteger const ERROR_CODE_AUTH;
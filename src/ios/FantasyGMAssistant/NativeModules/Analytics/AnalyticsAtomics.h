@@ -0,0 +1,56 @@
+//
+// AnalyticsAtomics.h
+// FantasyGMAssistant
+//
+// C11 atomic operations on 64-bit words for the lock-free analytics event ring
+// Version: 1.0.0
+//
+
+#ifndef AnalyticsAtomics_h
+#define AnalyticsAtomics_h
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+// Swift cannot spell C11 atomics directly, so the ring keeps plain uint64_t words in
+// memory it allocates itself and routes every shared access through these helpers.
+
+static inline uint64_t fgm_atomic_load_relaxed(uint64_t *word) {
+    return atomic_load_explicit((_Atomic uint64_t *)word, memory_order_relaxed);
+}
+
+static inline uint64_t fgm_atomic_load_acquire(uint64_t *word) {
+    return atomic_load_explicit((_Atomic uint64_t *)word, memory_order_acquire);
+}
+
+static inline void fgm_atomic_store_relaxed(uint64_t *word, uint64_t value) {
+    atomic_store_explicit((_Atomic uint64_t *)word, value, memory_order_relaxed);
+}
+
+static inline void fgm_atomic_store_release(uint64_t *word, uint64_t value) {
+    atomic_store_explicit((_Atomic uint64_t *)word, value, memory_order_release);
+}
+
+static inline uint64_t fgm_atomic_fetch_add_relaxed(uint64_t *word, uint64_t delta) {
+    return atomic_fetch_add_explicit((_Atomic uint64_t *)word, delta, memory_order_relaxed);
+}
+
+/// Weak compare-and-swap; on failure `expected` is updated with the current value
+static inline bool fgm_atomic_compare_exchange_relaxed(uint64_t *word, uint64_t *expected, uint64_t desired) {
+    return atomic_compare_exchange_weak_explicit((_Atomic uint64_t *)word, expected, desired,
+                                                 memory_order_relaxed, memory_order_relaxed);
+}
+
+/// Strong compare-and-swap with acquire/release ordering for one-shot flags
+static inline bool fgm_atomic_compare_exchange_acq_rel(uint64_t *word, uint64_t *expected, uint64_t desired) {
+    return atomic_compare_exchange_strong_explicit((_Atomic uint64_t *)word, expected, desired,
+                                                   memory_order_acq_rel, memory_order_acquire);
+}
+
+/// Full barrier for the store-then-load handshake between producers and the consumer
+static inline void fgm_atomic_thread_fence(void) {
+    atomic_thread_fence(memory_order_seq_cst);
+}
+
+#endif /* AnalyticsAtomics_h */
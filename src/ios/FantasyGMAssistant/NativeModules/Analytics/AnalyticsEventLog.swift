@@ -0,0 +1,277 @@
+//
+// AnalyticsEventLog.swift
+// FantasyGMAssistant
+//
+// Append-only on-disk log that keeps analytics events across launches until they are uploaded
+// Version: 1.0.0
+//
+
+import Foundation // iOS 14.0+
+
+// MARK: - Log Constants
+private let EVENT_LOG_FILE_NAME = "events.log"
+private let EVENT_CURSOR_FILE_NAME = "events.cursor"
+private let COMPACTION_MIN_BYTES: UInt64 = 1024 * 1024 // 1MB of uploaded records before rewriting the log
+private let RECOVERY_READ_CHUNK = 64 * 1024
+private let RECORD_SEPARATOR: UInt8 = 0x0A
+
+// MARK: - Log Errors
+enum AnalyticsEventLogError: Error {
+    case encodingFailed
+}
+
+// MARK: - Analytics Event
+/// A tracked event as persisted in the log and handed to the uploader
+public struct AnalyticsEvent {
+    public let name: String
+    public let parameters: [String: Any]
+    public let timestamp: Date
+    /// Share of events like this one that were kept when it was tracked; dashboards divide counts by it
+    public let sampleRate: Double
+    /// Tracked with `requiresPrivacy`; uploaded with the privacy-filtered session context
+    public var requiresPrivacy = false
+    /// `AnalyticsSessionContext` version current when the event was tracked; 0 when unknown
+    public var contextVersion = 0
+    
+    var isError: Bool {
+        return name.hasPrefix("error_")
+    }
+}
+
+extension AnalyticsEvent {
+    /// One JSON object per newline-terminated record. Values JSON cannot hold are stored by description.
+    func encoded() -> Data? {
+        var object: [String: Any] = [
+            "n": name,
+            "p": AnalyticsEvent.jsonSafe(parameters),
+            "t": timestamp.timeIntervalSince1970,
+            "s": sampleRate
+        ]
+        if requiresPrivacy {
+            object["r"] = true
+        }
+        if contextVersion > 0 {
+            object["c"] = contextVersion
+        }
+        guard var data = try? JSONSerialization.data(withJSONObject: object) else { return nil }
+        data.append(RECORD_SEPARATOR)
+        return data
+    }
+    
+    init?(record: Data) {
+        guard let object = (try? JSONSerialization.jsonObject(with: record)) as? [String: Any],
+              let name = object["n"] as? String,
+              let time = object["t"] as? TimeInterval else {
+            return nil
+        }
+        
+        self.init(name: name,
+                  parameters: object["p"] as? [String: Any] ?? [:],
+                  timestamp: Date(timeIntervalSince1970: time),
+                  sampleRate: object["s"] as? Double ?? 1,
+                  requiresPrivacy: object["r"] as? Bool ?? false,
+                  contextVersion: object["c"] as? Int ?? 0)
+    }
+    
+    private static func jsonSafe(_ value: Any) -> Any {
+        switch value {
+        case let dictionary as [String: Any]:
+            return dictionary.mapValues { jsonSafe($0) }
+        case let array as [Any]:
+            return array.map { jsonSafe($0) }
+        case is String, is NSNumber, is NSNull:
+            return value
+        case let date as Date:
+            return date.timeIntervalSince1970
+        default:
+            return String(describing: value)
+        }
+    }
+}
+
+// MARK: - Log Batch
+struct AnalyticsLogBatch {
+    let events: [AnalyticsEvent]
+    /// Log offset just past the last record read; acknowledged once the batch is uploaded
+    let endOffset: UInt64
+    /// Records consumed, including any unreadable ones that were skipped
+    let recordCount: Int
+}
+
+// MARK: - Event Log
+/// Events are appended as newline-terminated records and consumed from a persisted read cursor.
+/// Uploaded records are reclaimed by truncating once the log drains, or by rewriting the unread
+/// tail when enough of them pile up. Not thread-safe; the pipeline serializes all access.
+final class AnalyticsEventLog {
+    private let logURL: URL
+    private let cursorURL: URL
+    private var fileHandle: FileHandle
+    private var cursor: UInt64 = 0
+    private var fileLength: UInt64 = 0
+    
+    /// Records appended but not yet acknowledged
+    private(set) var pendingCount = 0
+    
+    /// Bytes of records appended but not yet acknowledged
+    var pendingBytes: Int {
+        return Int(fileLength - cursor)
+    }
+    
+    init?(directory: URL) {
+        let fileManager = FileManager.default
+        if !fileManager.fileExists(atPath: directory.path) {
+            try? fileManager.createDirectory(at: directory, withIntermediateDirectories: true)
+        }
+        
+        logURL = directory.appendingPathComponent(EVENT_LOG_FILE_NAME)
+        cursorURL = directory.appendingPathComponent(EVENT_CURSOR_FILE_NAME)
+        if !fileManager.fileExists(atPath: logURL.path) {
+            guard fileManager.createFile(atPath: logURL.path, contents: nil) else { return nil }
+        }
+        
+        guard let handle = try? FileHandle(forUpdating: logURL) else { return nil }
+        fileHandle = handle
+        
+        recover()
+    }
+    
+    deinit {
+        try? fileHandle.close()
+    }
+    
+    // MARK: - Writes
+    func append(_ event: AnalyticsEvent) throws {
+        guard let record = event.encoded() else { throw AnalyticsEventLogError.encodingFailed }
+        
+        try fileHandle.seek(toOffset: fileLength)
+        try fileHandle.write(contentsOf: record)
+        fileLength += UInt64(record.count)
+        pendingCount += 1
+    }
+    
+    /// Advances the cursor past an uploaded batch and reclaims space when worthwhile
+    func acknowledge(_ batch: AnalyticsLogBatch) {
+        cursor = min(batch.endOffset, fileLength)
+        pendingCount = max(0, pendingCount - batch.recordCount)
+        
+        if cursor == fileLength {
+            removeAll()
+        } else if cursor >= COMPACTION_MIN_BYTES && cursor > fileLength / 2 {
+            compact()
+        } else {
+            persistCursor()
+        }
+    }
+    
+    /// Drops every record, uploaded or not
+    func removeAll() {
+        try? fileHandle.truncate(atOffset: 0)
+        fileLength = 0
+        cursor = 0
+        pendingCount = 0
+        persistCursor()
+    }
+    
+    // MARK: - Reads
+    /// Reads whole records from the cursor, stopping at `maxCount` records or `maxBytes` bytes.
+    /// A single record larger than `maxBytes` is still returned on its own so the log never stalls.
+    func readBatch(maxCount: Int, maxBytes: Int) throws -> AnalyticsLogBatch {
+        var chunkSize = min(max(maxBytes, 1), pendingBytes)
+        
+        while chunkSize > 0 {
+            try fileHandle.seek(toOffset: cursor)
+            let chunk = try fileHandle.read(upToCount: chunkSize) ?? Data()
+            
+            var events: [AnalyticsEvent] = []
+            var recordCount = 0
+            var start = chunk.startIndex
+            while recordCount < maxCount, let end = chunk[start...].firstIndex(of: RECORD_SEPARATOR) {
+                if let event = AnalyticsEvent(record: chunk[start..<end]) {
+                    events.append(event)
+                } else {
+                    Logger.shared.error("Skipping unreadable analytics log record", error: nil)
+                }
+                recordCount += 1
+                start = chunk.index(after: end)
+            }
+            
+            if recordCount > 0 || chunkSize >= pendingBytes {
+                let consumed = UInt64(chunk.distance(from: chunk.startIndex, to: start))
+                return AnalyticsLogBatch(events: events, endOffset: cursor + consumed, recordCount: recordCount)
+            }
+            chunkSize = min(chunkSize * 2, pendingBytes)
+        }
+        
+        return AnalyticsLogBatch(events: [], endOffset: cursor, recordCount: 0)
+    }
+    
+    // MARK: - Private Methods
+    /// Restores the cursor and pending count after launch.
+    /// A torn record at the tail (e.g. from a crash mid-append) is truncated away.
+    private func recover() {
+        fileLength = (try? fileHandle.seekToEnd()) ?? 0
+        if let data = try? Data(contentsOf: cursorURL), data.count == MemoryLayout<UInt64>.size {
+            cursor = data.withUnsafeBytes { UInt64(littleEndian: $0.loadUnaligned(as: UInt64.self)) }
+        }
+        if cursor > fileLength {
+            cursor = 0
+        }
+        
+        var offset = cursor
+        var recordEnd = cursor
+        try? fileHandle.seek(toOffset: cursor)
+        while let chunk = try? fileHandle.read(upToCount: RECOVERY_READ_CHUNK), !chunk.isEmpty {
+            for (position, byte) in chunk.enumerated() where byte == RECORD_SEPARATOR {
+                pendingCount += 1
+                recordEnd = offset + UInt64(position) + 1
+            }
+            offset += UInt64(chunk.count)
+        }
+        
+        if recordEnd < fileLength {
+            try? fileHandle.truncate(atOffset: recordEnd)
+            fileLength = recordEnd
+        }
+    }
+    
+    private func persistCursor() {
+        let data = withUnsafeBytes(of: cursor.littleEndian) { Data($0) }
+        do {
+            try data.write(to: cursorURL, options: .atomic)
+        } catch {
+            Logger.shared.error("Failed to persist analytics log cursor", error: error)
+        }
+    }
+    
+    /// Rewrites the unread tail into a fresh log. The cursor is reset before the swap, so a crash
+    /// in between resends uploaded events rather than losing pending ones.
+    private func compact() {
+        let compactURL = logURL.appendingPathExtension("compact")
+        let tailStart = cursor
+        
+        do {
+            try fileHandle.seek(toOffset: cursor)
+            let tail = try fileHandle.readToEnd() ?? Data()
+            try tail.write(to: compactURL)
+            
+            cursor = 0
+            persistCursor()
+            let handle = try FileHandle(forUpdating: compactURL)
+            guard rename(compactURL.path, logURL.path) == 0 else {
+                try? handle.close()
+                throw CocoaError(.fileWriteUnknown)
+            }
+            
+            try? fileHandle.close()
+            fileHandle = handle
+            fileLength = UInt64(tail.count)
+            
+            Logger.shared.debug("Compacted analytics event log to \(tail.count) bytes")
+        } catch {
+            try? FileManager.default.removeItem(at: compactURL)
+            cursor = tailStart
+            persistCursor()
+            Logger.shared.error("Analytics event log compaction failed", error: error)
+        }
+    }
+}
@@ -0,0 +1,153 @@
+//
+// AnalyticsEventRing.swift
+// FantasyGMAssistant
+//
+// Fixed-capacity lock-free ring that takes tracked events off the caller's thread
+// Version: 1.0.0
+//
+
+import Foundation // iOS 14.0+
+
+// MARK: - Ring Constants
+private let CUSTOM_EVENT_NAME_ID: UInt16 = .max
+// Shared words sit 128 bytes apart so producers and the consumer do not false-share a cache line
+private let TAIL_WORD = 0
+private let DRAIN_REQUEST_WORD = 16
+private let OVERFLOW_WORD = 32
+private let SHARED_WORD_COUNT = 48
+
+// MARK: - Event Record
+/// Compact record held in a preallocated ring slot. Known event names travel as interned IDs,
+/// and the caller's parameter dictionary is retained as-is rather than copied or enriched.
+struct AnalyticsEventRecord {
+    var nameID: UInt16 = CUSTOM_EVENT_NAME_ID
+    var requiresPrivacy = false
+    var timestamp: CFAbsoluteTime = 0
+    var customName: String?
+    var parameters: [String: Any]?
+}
+
+// MARK: - Event Ring
+/// Bounded multi-producer, single-consumer queue using per-slot sequence numbers.
+/// Producers claim a slot with a single compare-and-swap on the tail, retried only when another
+/// producer took the same slot first, and never block, hop queues or allocate. A full ring is
+/// reported to the caller instead of waiting. Only one thread at a time may drain.
+final class AnalyticsEventRing {
+    private let capacity: Int
+    private let mask: UInt64
+    private let sequences: UnsafeMutablePointer<UInt64>
+    private let records: UnsafeMutablePointer<AnalyticsEventRecord>
+    private let shared: UnsafeMutablePointer<UInt64>
+    /// Read position, owned by the consumer
+    private var head: UInt64 = 0
+    private let nameIDs: [String: UInt16]
+    private let names: [String]
+    
+    /// - Parameters:
+    ///   - capacity: Number of slots; must be a power of two
+    ///   - names: Event names to intern. Immutable after init, so producers read it without locking.
+    init(capacity: Int, names: [String]) {
+        precondition(capacity > 0 && capacity & (capacity - 1) == 0, "Ring capacity must be a power of two")
+        precondition(names.count < Int(CUSTOM_EVENT_NAME_ID), "Too many interned event names")
+        
+        self.capacity = capacity
+        self.mask = UInt64(capacity - 1)
+        self.names = names
+        var ids: [String: UInt16] = [:]
+        for (index, name) in names.enumerated() {
+            ids[name] = UInt16(index)
+        }
+        self.nameIDs = ids
+        
+        sequences = .allocate(capacity: capacity)
+        for slot in 0..<capacity {
+            (sequences + slot).initialize(to: UInt64(slot))
+        }
+        records = .allocate(capacity: capacity)
+        records.initialize(repeating: AnalyticsEventRecord(), count: capacity)
+        shared = .allocate(capacity: SHARED_WORD_COUNT)
+        shared.initialize(repeating: 0, count: SHARED_WORD_COUNT)
+    }
+    
+    deinit {
+        sequences.deallocate()
+        records.deinitialize(count: capacity)
+        records.deallocate()
+        shared.deallocate()
+    }
+    
+    /// Events rejected because the ring was full
+    var overflowCount: Int {
+        return Int(fgm_atomic_load_relaxed(shared + OVERFLOW_WORD))
+    }
+    
+    // MARK: - Producers
+    /// Publishes the event to a free slot. Returns false, without blocking, when the ring is full.
+    func enqueue(_ name: String, parameters: [String: Any]?, requiresPrivacy: Bool) -> Bool {
+        let nameID = nameIDs[name]
+        let record = AnalyticsEventRecord(nameID: nameID ?? CUSTOM_EVENT_NAME_ID,
+                                          requiresPrivacy: requiresPrivacy,
+                                          timestamp: CFAbsoluteTimeGetCurrent(),
+                                          customName: nameID == nil ? name : nil,
+                                          parameters: parameters)
+        
+        let tail = shared + TAIL_WORD
+        var position = fgm_atomic_load_relaxed(tail)
+        while true {
+            let slot = Int(position & mask)
+            let lag = Int64(bitPattern: fgm_atomic_load_acquire(sequences + slot) &- position)
+            
+            if lag == 0 {
+                // On failure the CAS reloads `position` with the tail another producer advanced to
+                if fgm_atomic_compare_exchange_relaxed(tail, &position, position &+ 1) {
+                    records[slot] = record
+                    fgm_atomic_store_release(sequences + slot, position &+ 1)
+                    return true
+                }
+            } else if lag < 0 {
+                // The slot still holds an event from one lap ago that the consumer has not read
+                _ = fgm_atomic_fetch_add_relaxed(shared + OVERFLOW_WORD, 1)
+                return false
+            } else {
+                position = fgm_atomic_load_relaxed(tail)
+            }
+        }
+    }
+    
+    /// Returns true for exactly one producer after the consumer last began draining, so a burst of
+    /// events schedules the consumer once instead of once per event
+    func requestDrain() -> Bool {
+        // Pairs with the fence in `beginDrain`: either this producer sees the request cleared and
+        // schedules a drain, or the consumer sees the event it just published
+        fgm_atomic_thread_fence()
+        var expected: UInt64 = 0
+        return fgm_atomic_compare_exchange_acq_rel(shared + DRAIN_REQUEST_WORD, &expected, 1)
+    }
+    
+    // MARK: - Consumer
+    /// Clears the drain request before reading, so events published from here on request again
+    func beginDrain() {
+        fgm_atomic_store_release(shared + DRAIN_REQUEST_WORD, 0)
+        fgm_atomic_thread_fence()
+    }
+    
+    /// Hands every published record to `body` in order, releasing each slot before the call.
+    /// Returns the number of records drained.
+    @discardableResult
+    func drain(_ body: (_ name: String, _ record: AnalyticsEventRecord) -> Void) -> Int {
+        var drained = 0
+        while true {
+            let slot = Int(head & mask)
+            guard fgm_atomic_load_acquire(sequences + slot) == head &+ 1 else { break }
+            
+            let record = (records + slot).move()
+            (records + slot).initialize(to: AnalyticsEventRecord())
+            fgm_atomic_store_release(sequences + slot, head &+ UInt64(capacity))
+            head &+= 1
+            
+            body(record.customName ?? names[Int(record.nameID)], record)
+            drained += 1
+        }
+        return drained
+    }
+}
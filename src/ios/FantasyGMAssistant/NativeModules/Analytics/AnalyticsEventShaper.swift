@@ -0,0 +1,129 @@
+//
+// AnalyticsEventShaper.swift
+// FantasyGMAssistant
+//
+// Per-event-type sampling and token-bucket rate limits for analytics ingestion
+// Version: 1.0.0
+//
+
+import Foundation // iOS 14.0+
+
+// MARK: - Shaping Constants
+private let SUMMARY_INTERVAL: TimeInterval = 60
+
+// MARK: - Event Rule
+public struct AnalyticsEventRule: Equatable {
+    /// Share of events kept, 0...1. Kept events report it so dashboards can rescale counts.
+    public var sampleRate: Double
+    /// Sustained events per second let through after sampling; nil disables rate limiting
+    public var ratePerSecond: Double?
+    /// Events allowed through at once above the sustained rate
+    public var burst: Double
+    
+    public init(sampleRate: Double = 1, ratePerSecond: Double? = nil, burst: Double = 1) {
+        self.sampleRate = min(max(sampleRate, 0), 1)
+        self.ratePerSecond = ratePerSecond.map { max($0, 0) }
+        self.burst = max(burst, 1)
+    }
+    
+    /// Parses the remote config form: `{"sample_rate": 0.25, "rate_per_second": 5, "burst": 20}`
+    public init?(dictionary: [String: Any]) {
+        let sampleRate = (dictionary["sample_rate"] as? NSNumber)?.doubleValue
+        let ratePerSecond = (dictionary["rate_per_second"] as? NSNumber)?.doubleValue
+        guard sampleRate != nil || ratePerSecond != nil else { return nil }
+        
+        self.init(sampleRate: sampleRate ?? 1,
+                  ratePerSecond: ratePerSecond,
+                  burst: (dictionary["burst"] as? NSNumber)?.doubleValue ?? ratePerSecond ?? 1)
+    }
+}
+
+// MARK: - Shaping Decision
+enum AnalyticsShapingDecision: Equatable {
+    case keep(sampleRate: Double)
+    case sampledOut
+    case rateLimited
+}
+
+// MARK: - Event Shaper
+/// Decides per event whether it is kept, sampled out or rate limited, and counts every drop by
+/// event name so the counts can be reported. Error events always bypass shaping.
+final class AnalyticsEventShaper {
+    private struct Bucket {
+        var tokens: Double
+        var updatedAt: CFAbsoluteTime
+    }
+    
+    private let lock = NSLock()
+    private let random: () -> Double
+    private var rules: [String: AnalyticsEventRule]
+    private var buckets: [String: Bucket] = [:]
+    private var sampledOut: [String: Int] = [:]
+    private var rateLimited: [String: Int] = [:]
+    private var lastSummary: CFAbsoluteTime
+    
+    init(rules: [String: AnalyticsEventRule],
+         now: CFAbsoluteTime = CFAbsoluteTimeGetCurrent(),
+         random: @escaping () -> Double = { Double.random(in: 0..<1) }) {
+        self.rules = rules
+        self.lastSummary = now
+        self.random = random
+    }
+    
+    /// Replaces every rule. Buckets restart full so a tightened limit applies from the next event.
+    func updateRules(_ newRules: [String: AnalyticsEventRule]) {
+        lock.lock()
+        defer { lock.unlock() }
+        
+        rules = newRules
+        buckets.removeAll()
+    }
+    
+    func decide(_ eventName: String, at time: CFAbsoluteTime) -> AnalyticsShapingDecision {
+        guard !eventName.hasPrefix("error_") else { return .keep(sampleRate: 1) }
+        
+        lock.lock()
+        defer { lock.unlock() }
+        
+        guard let rule = rules[eventName] else { return .keep(sampleRate: 1) }
+        
+        // Sample first so rate limits apply to the stream that would actually be sent
+        if rule.sampleRate < 1 && random() >= rule.sampleRate {
+            sampledOut[eventName, default: 0] += 1
+            return .sampledOut
+        }
+        
+        if let ratePerSecond = rule.ratePerSecond {
+            var bucket = buckets[eventName] ?? Bucket(tokens: rule.burst, updatedAt: time)
+            let elapsed = max(0, time - bucket.updatedAt)
+            bucket.tokens = min(rule.burst, bucket.tokens + elapsed * ratePerSecond)
+            bucket.updatedAt = max(bucket.updatedAt, time)
+            
+            guard bucket.tokens >= 1 else {
+                buckets[eventName] = bucket
+                rateLimited[eventName, default: 0] += 1
+                return .rateLimited
+            }
+            bucket.tokens -= 1
+            buckets[eventName] = bucket
+        }
+        
+        return .keep(sampleRate: rule.sampleRate)
+    }
+    
+    /// Drop counts since the last summary, by event name, once per summary interval
+    func takeSummary(at time: CFAbsoluteTime) -> (sampledOut: [String: Int], rateLimited: [String: Int])? {
+        lock.lock()
+        defer { lock.unlock() }
+        
+        guard time - lastSummary >= SUMMARY_INTERVAL, !sampledOut.isEmpty || !rateLimited.isEmpty else {
+            return nil
+        }
+        
+        let summary = (sampledOut, rateLimited)
+        sampledOut.removeAll()
+        rateLimited.removeAll()
+        lastSummary = time
+        return summary
+    }
+}
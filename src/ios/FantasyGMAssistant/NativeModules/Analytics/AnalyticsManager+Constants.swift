@@ -0,0 +1,56 @@
+//
+// AnalyticsManager+Constants.swift
+// FantasyGMAssistant
+//
+// Event and property names used by AnalyticsManager and its extensions
+// Version: 1.0.0
+//
+
+import Foundation // iOS 14.0+
+
+// Nested so they shadow the app-wide `AnalyticsEvents` in Constants.swift inside the manager only
+extension AnalyticsManager {
+    // MARK: - Analytics Event Constants
+    struct AnalyticsEvents {
+        static let LOGIN = "user_login"
+        static let LOGOUT = "user_logout"
+        static let VIEW_TEAM = "view_team"
+        static let UPDATE_LINEUP = "update_lineup"
+        static let RUN_SIMULATION = "run_simulation"
+        static let ANALYZE_TRADE = "analyze_trade"
+        static let GENERATE_VIDEO = "generate_video"
+        static let VIEW_PLAYER = "view_player"
+        static let BATCH = "analytics_batch"
+        static let SAMPLING_SUMMARY = "analytics_sampling_summary"
+        
+        /// Interned by the event ring; order fixes the IDs for the process lifetime
+        static let all = [
+            LOGIN, LOGOUT, VIEW_TEAM, UPDATE_LINEUP, RUN_SIMULATION, ANALYZE_TRADE, GENERATE_VIDEO, VIEW_PLAYER
+        ]
+    }
+    
+    // MARK: - Analytics Property Constants
+    struct AnalyticsProperties {
+        static let USER_ID = "user_id"
+        static let TEAM_ID = "team_id"
+        static let SPORT_TYPE = "sport_type"
+        static let PREMIUM_STATUS = "is_premium"
+        static let FEATURE_NAME = "feature_name"
+        static let DURATION_MS = "duration_ms"
+        static let ERROR_TYPE = "error_type"
+        static let ERROR_MESSAGE = "error_message"
+        static let DEVICE_INFO = "device_info"
+        static let APP_VERSION = "app_version"
+        static let NETWORK_STATUS = "network_status"
+        static let ERROR_CODE = "error_code"
+        static let RETRY_COUNT = "retry_count"
+        static let BATCH_ID = "batch_id"
+        static let EVENT_NAME = "event_name"
+        static let EVENT_TIMESTAMP = "event_timestamp"
+        static let SAMPLE_RATE = "sample_rate"
+        static let EVENT_COUNT = "event_count"
+        static let EVENTS = "events"
+        static let SAMPLED_OUT = "sampled_out"
+        static let RATE_LIMITED = "rate_limited"
+    }
+}
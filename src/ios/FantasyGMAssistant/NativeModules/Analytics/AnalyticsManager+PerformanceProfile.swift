@@ -0,0 +1,28 @@
+//
+// AnalyticsManager+PerformanceProfile.swift
+// FantasyGMAssistant
+//
+// Batching interval adapted to the published performance profile
+// Version: 1.0.0
+//
+
+import Foundation // iOS 14.0+
+
+extension AnalyticsManager: PerformanceProfileObserver {
+    // MARK: - Batch Interval
+    /// Fewer, larger uploads keep the radio and CPU idle longer on slow, hot or power-saving devices.
+    /// Count and size triggers are unchanged, so a busy session still uploads promptly.
+    static func maxBatchAge(for profile: PerformanceProfile) -> TimeInterval {
+        switch profile.level {
+        case .full: return 30
+        case .reduced: return 60
+        case .minimal: return 120
+        }
+    }
+    
+    public func performanceProfileDidChange(_ profile: PerformanceProfile) {
+        let maxBatchAge = AnalyticsManager.maxBatchAge(for: profile)
+        pipeline?.setMaxBatchAge(maxBatchAge)
+        Logger.shared.debug("Analytics batch interval set to \(Int(maxBatchAge))s")
+    }
+}
@@ -0,0 +1,53 @@
+//
+// AnalyticsManager+Sampling.swift
+// FantasyGMAssistant
+//
+// Remotely updatable per-event sampling and rate limits for AnalyticsManager
+// Version: 1.0.0
+//
+
+import Foundation // iOS 14.0+
+
+extension AnalyticsManager {
+    // MARK: - Default Rules
+    /// High-frequency browsing events are thinned until remote config says otherwise.
+    /// Events without a rule, including every error, are always sent in full.
+    static let defaultEventRules: [String: AnalyticsEventRule] = [
+        AnalyticsEvents.VIEW_PLAYER: AnalyticsEventRule(sampleRate: 0.5, ratePerSecond: 10, burst: 20),
+        AnalyticsEvents.UPDATE_LINEUP: AnalyticsEventRule(ratePerSecond: 5, burst: 30)
+    ]
+    
+    // MARK: - Rule Updates
+    /// Replaces every sampling rule. Event types left out are sent in full.
+    public func updateEventRules(_ rules: [String: AnalyticsEventRule]) {
+        shaper.updateRules(rules)
+        Logger.shared.debug("Analytics sampling rules updated for \(rules.count) event types")
+    }
+    
+    /// Remote config form: `{"view_player": {"sample_rate": 0.25, "rate_per_second": 5, "burst": 20}}`.
+    /// Entries that do not parse are skipped. Returns the number of rules applied.
+    @discardableResult
+    @objc public func updateEventRules(fromConfig config: [String: Any]) -> Int {
+        var rules: [String: AnalyticsEventRule] = [:]
+        for (eventName, value) in config {
+            guard let dictionary = value as? [String: Any], let rule = AnalyticsEventRule(dictionary: dictionary) else {
+                Logger.shared.error("Ignoring invalid sampling rule for event: \(eventName)")
+                continue
+            }
+            rules[eventName] = rule
+        }
+        
+        updateEventRules(rules)
+        return rules.count
+    }
+    
+    // MARK: - Sampling Summary
+    /// Per-event drop counts for the summary event, or nil when no summary is due
+    func samplingSummaryParameters(at time: CFAbsoluteTime) -> [String: Any]? {
+        guard let summary = shaper.takeSummary(at: time) else { return nil }
+        return [
+            AnalyticsProperties.SAMPLED_OUT: summary.sampledOut,
+            AnalyticsProperties.RATE_LIMITED: summary.rateLimited
+        ]
+    }
+}
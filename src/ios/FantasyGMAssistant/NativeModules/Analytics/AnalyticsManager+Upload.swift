@@ -0,0 +1,85 @@
+//
+// AnalyticsManager+Upload.swift
+// FantasyGMAssistant
+//
+// Turns flushed analytics batches into DataDog RUM actions, one per session context version
+// Version: 1.0.0
+//
+
+import Foundation // iOS 14.0+
+import DatadogRUM // 1.5.0+
+
+extension AnalyticsManager {
+    // MARK: - Context Groups
+    /// The events of one uploaded batch that were tracked under the same context version
+    private struct ContextGroup {
+        let snapshot: AnalyticsSessionContext.Snapshot
+        var actions: [[String: Any]] = []
+        var privateActions: [[String: Any]] = []
+    }
+    
+    // MARK: - Upload
+    /// Sends one flushed batch: errors individually, everything else as one RUM action per context
+    /// version carrying that context once. Privacy-flagged events go in a second action per version
+    /// with the filtered context. Not traced: PerformanceTracer exports through this path, so an upload
+    /// span would schedule another upload.
+    func uploadBatch(_ events: [AnalyticsEvent], batchID: String) -> Bool {
+        let latest = context.snapshot()
+        var groups: [ContextGroup] = []
+        var groupIndex: [Int: Int] = [:]
+        
+        for event in events {
+            // Only events older than the kept history, or logged before versions were, fall back
+            let snapshot = context.snapshot(version: event.contextVersion) ?? latest
+            var attributes = event.parameters
+            attributes[AnalyticsProperties.SAMPLE_RATE] = event.sampleRate
+            
+            if event.isError {
+                attributes[AnalyticsProperties.BATCH_ID] = batchID
+                attributes.merge(snapshot.attributes) { current, _ in current }
+                sendError(String(event.name.dropFirst("error_".count)), parameters: attributes)
+                continue
+            }
+            
+            attributes[AnalyticsProperties.EVENT_NAME] = event.name
+            attributes[AnalyticsProperties.EVENT_TIMESTAMP] = event.timestamp.timeIntervalSince1970
+            let index: Int
+            if let existing = groupIndex[snapshot.version] {
+                index = existing
+            } else {
+                index = groups.count
+                groupIndex[snapshot.version] = index
+                groups.append(ContextGroup(snapshot: snapshot))
+            }
+            if event.requiresPrivacy {
+                groups[index].privateActions.append(attributes)
+            } else {
+                groups[index].actions.append(attributes)
+            }
+        }
+        
+        for group in groups {
+            sendBatchAction(group.actions, context: group.snapshot.attributes, batchID: batchID)
+            sendBatchAction(group.privateActions, context: group.snapshot.filteredAttributes, batchID: batchID)
+        }
+        return true
+    }
+    
+    private func sendBatchAction(_ actions: [[String: Any]], context: [String: Any], batchID: String) {
+        guard !actions.isEmpty else { return }
+        
+        var attributes = context
+        attributes[AnalyticsProperties.BATCH_ID] = batchID
+        attributes[AnalyticsProperties.EVENT_COUNT] = actions.count
+        attributes[AnalyticsProperties.EVENTS] = actions
+        Global.rum.addAction(type: .custom, name: AnalyticsEvents.BATCH, attributes: attributes)
+    }
+    
+    func sendError(_ errorName: String, parameters: [String: Any]) {
+        Global.rum.addError(
+            message: parameters[AnalyticsProperties.ERROR_MESSAGE] as? String ?? errorName,
+            source: .custom,
+            attributes: parameters
+        )
+    }
+}
@@ -10,52 +10,32 @@ import Foundation // iOS 14.0+
 import DatadogCore // 1.5.0+
 import DatadogRUM // 1.5.0+
 
-// MARK: - Analytics Event Constants
-private struct AnalyticsEvents {
-    static let LOGIN = "user_login"
-    static let LOGOUT = "user_logout"
-    static let VIEW_TEAM = "view_team"
-    static let UPDATE_LINEUP = "update_lineup"
-    static let RUN_SIMULATION = "run_simulation"
-    static let ANALYZE_TRADE = "analyze_trade"
-    static let GENERATE_VIDEO = "generate_video"
-    static let VIEW_PLAYER = "view_player"
-}
-
-// MARK: - Analytics Property Constants
-private struct AnalyticsProperties {
-    static let USER_ID = "user_id"
-    static let TEAM_ID = "team_id"
-    static let SPORT_TYPE = "sport_type"
-    static let PREMIUM_STATUS = "is_premium"
-    static let FEATURE_NAME = "feature_name"
-    static let DURATION_MS = "duration_ms"
-    static let ERROR_TYPE = "error_type"
-    static let ERROR_MESSAGE = "error_message"
-    static let DEVICE_INFO = "device_info"
-    static let APP_VERSION = "app_version"
-    static let NETWORK_STATUS = "network_status"
-    static let ERROR_CODE = "error_code"
-    static let RETRY_COUNT = "retry_count"
-    static let BATCH_ID = "batch_id"
-}
+// MARK: - Pipeline Constants
+private let EVENT_LOG_DIRECTORY = "Analytics"
+private let CONTEXT_HISTORY_FILE_NAME = "context_history.json"
+private let EVENT_RING_CAPACITY = 2048
 
 // MARK: - AnalyticsManager
-public final class AnalyticsManager {
+@objc public final class AnalyticsManager: NSObject {
     // MARK: - Properties
-    public static let shared = AnalyticsManager()
+    @objc public static let shared = AnalyticsManager()
     
     private let datadogConfig: DatadogConfiguration
     private let rumConfig: RUMConfiguration
-    private var userProperties: [String: Any]
-    private var eventQueue: [(name: String, parameters: [String: Any])]
-    private let maxQueueSize: Int = 1000
+    /// Session context snapshots by version; read by the uploader
+    let context: AnalyticsSessionContext
+    private(set) var pipeline: AnalyticsPipeline?
+    private let eventRing = AnalyticsEventRing(capacity: EVENT_RING_CAPACITY, names: AnalyticsEvents.all)
+    /// Sole consumer of `eventRing`; enriches drained events off the tracking thread
+    private let ingestQueue = DispatchQueue(label: "com.fantasygm.analytics.ingest", qos: .utility)
     private let maxRetryAttempts: Int = 3
     private var networkMonitor: NWPathMonitor?
     private let privacyManager: PrivacyManager
+    /// Per-event sampling and rate limits, applied before events are persisted
+    let shaper = AnalyticsEventShaper(rules: AnalyticsManager.defaultEventRules)
     
     // MARK: - Initialization
-    private init() {
+    private override init() {
         // Initialize DataDog configuration
         datadogConfig = DatadogConfiguration()
             .set(trackingConsent: .pending)
@@ -72,16 +52,33 @@ public final class AnalyticsManager {
             .trackErrors()
         
         // Initialize properties
-        userProperties = [:]
-        eventQueue = []
-        privacyManager = PrivacyManager()
+        let privacy = PrivacyManager()
+        privacyManager = privacy
         
-        // Setup device info
-        setupDeviceInfo()
+        // Built once per context change and attached per group of events rather than merged into
+        // every event. Kept beside the event log so events persisted offline keep their context.
+        let supportURL = FileManager.default.urls(for: .applicationSupportDirectory, in: .userDomainMask)[0]
+        let logDirectory = supportURL.appendingPathComponent(EVENT_LOG_DIRECTORY)
+        context = AnalyticsSessionContext(
+            staticAttributes: AnalyticsManager.staticContextAttributes(),
+            networkStatusKey: AnalyticsProperties.NETWORK_STATUS,
+            historyURL: logDirectory.appendingPathComponent(CONTEXT_HISTORY_FILE_NAME)
+        ) { attributes in
+            privacy.filterSensitiveData(from: attributes)
+        }
+        super.init()
+        
+        // Events are persisted before upload so nothing tracked offline is lost if the app is killed
+        pipeline = AnalyticsPipeline(directory: logDirectory) { [weak self] events, batchID in
+            return self?.uploadBatch(events, batchID: batchID) ?? false
+        }
         
         // Initialize network monitoring
         setupNetworkMonitoring()
         
+        // Batch less often when the device is slow, hot or saving power
+        PerformanceProfileMonitor.shared.register(self)
+        
         Logger.shared.debug("AnalyticsManager initialized")
     }
     
@@ -111,29 +108,49 @@ public final class AnalyticsManager {
     }
     
     // MARK: - Event Tracking
+    /// Safe to call from hot UI paths and the bridge thread: the event is published to a lock-free
+    /// ring and enriched, filtered and persisted later on the ingest queue. Falls back to the
+    /// direct path when full.
+    @objc(trackEvent:parameters:requiresPrivacy:)
     public func trackEvent(
         _ eventName: String,
         parameters: [String: Any]? = nil,
         requiresPrivacy: Bool = false
     ) {
-        let enrichedParams = enrichEventParameters(parameters)
-        
-        guard validateEvent(eventName, parameters: enrichedParams) else {
+        guard !eventName.isEmpty else {
             Logger.shared.error("Invalid event tracking attempt: \(eventName)")
             return
         }
         
-        let finalParams = requiresPrivacy ? 
-            privacyManager.filterSensitiveData(from: enrichedParams) : 
-            enrichedParams
-        
-        if isNetworkAvailable() {
-            sendEvent(eventName, parameters: finalParams)
-        } else {
-            queueEvent(eventName, parameters: finalParams)
+        guard eventRing.enqueue(eventName, parameters: parameters, requiresPrivacy: requiresPrivacy) else {
+            recordEvent(eventName, parameters: parameters, requiresPrivacy: requiresPrivacy, completion: nil)
+            return
         }
         
-        Logger.shared.debug("Tracked event: \(eventName)")
+        if eventRing.requestDrain() {
+            ingestQueue.async { [weak self] in
+                self?.drainEventRing()
+            }
+        }
+    }
+    
+    /// Replaces the user properties reported with events tracked from now on. Events already in the
+    /// ring are drained first, so they keep the properties they were tracked under.
+    @objc public func setUserProperties(_ properties: [String: Any]) {
+        ingestQueue.async { [weak self] in
+            guard let self = self else { return }
+            self.drainEventRing()
+            self.context.setUserProperties(properties)
+        }
+    }
+    
+    /// Uploads every persisted event now. Backs the bridge's `syncOfflineEvents`.
+    @objc public func flushEvents(completion: @escaping (_ uploaded: Int, _ remaining: Int) -> Void) {
+        guard let pipeline = pipeline else {
+            completion(0, 0)
+            return
+        }
+        pipeline.flush(completion: completion)
     }
     
     // MARK: - Error Tracking
@@ -148,102 +165,174 @@ public final class AnalyticsManager {
         errorProps[AnalyticsProperties.ERROR_MESSAGE] = errorMessage
         errorProps[AnalyticsProperties.ERROR_CODE] = errorCode
         
-        let enrichedProps = enrichEventParameters(errorProps)
-        
         if isNetworkAvailable() {
-            sendError(errorName, parameters: enrichedProps)
+            sendError(errorName, parameters: enrichEventParameters(errorProps))
         } else {
-            queueEvent("error_\(errorName)", parameters: enrichedProps)
+            let eventParams = eventParameters(errorProps, requiresPrivacy: false)
+            persistEvent("error_\(errorName)", parameters: eventParams, completion: nil)
         }
         
         Logger.shared.error("\(errorName): \(errorMessage)", error: nil)
     }
     
     // MARK: - Private Methods
-    private func setupDeviceInfo() {
-        userProperties[AnalyticsProperties.DEVICE_INFO] = [
-            "model": UIDevice.current.model,
-            "systemVersion": UIDevice.current.systemVersion,
-            "appVersion": Bundle.main.infoDictionary?["CFBundleShortVersionString"] as? String ?? "unknown"
+    private func recordEvent(
+        _ eventName: String,
+        parameters: [String: Any]?,
+        requiresPrivacy: Bool,
+        completion: ((Error?) -> Void)?
+    ) {
+        let eventParams = parameters ?? [:]
+        
+        guard validateEvent(eventName, parameters: eventParams) else {
+            Logger.shared.error("Invalid event tracking attempt: \(eventName)")
+            completion?(nil)
+            return
+        }
+        
+        let now = CFAbsoluteTimeGetCurrent()
+        guard case .keep(let sampleRate) = shaper.decide(eventName, at: now) else {
+            completion?(nil)
+            return
+        }
+        
+        persistEvent(eventName,
+                     parameters: eventParameters(eventParams, requiresPrivacy: requiresPrivacy),
+                     requiresPrivacy: requiresPrivacy,
+                     sampleRate: sampleRate,
+                     completion: completion)
+        persistSamplingSummaryIfNeeded(at: now)
+        Logger.shared.debug("Tracked event: \(eventName)")
+    }
+    
+    /// Runs on `ingestQueue`. Moves every published event from the ring into the pipeline at once.
+    private func drainEventRing() {
+        eventRing.beginDrain()
+        
+        // Context changes are applied on this queue after a drain, so the whole drain shares one version
+        let contextVersion = context.snapshot().version
+        var events: [AnalyticsPipeline.PendingEvent] = []
+        eventRing.drain { eventName, record in
+            // Shaped before enrichment so dropped events cost no parameter filtering
+            guard case .keep(let sampleRate) = shaper.decide(eventName, at: record.timestamp) else { return }
+            events.append(AnalyticsPipeline.PendingEvent(
+                name: eventName,
+                parameters: eventParameters(record.parameters ?? [:], requiresPrivacy: record.requiresPrivacy),
+                priority: priority(for: eventName),
+                timestamp: Date(timeIntervalSinceReferenceDate: record.timestamp),
+                requiresPrivacy: record.requiresPrivacy,
+                sampleRate: sampleRate,
+                contextVersion: contextVersion
+            ))
+        }
+        defer { persistSamplingSummaryIfNeeded(at: CFAbsoluteTimeGetCurrent()) }
+        
+        guard let pipeline = pipeline else {
+            _ = uploadBatch(events.map {
+                AnalyticsEvent(name: $0.name,
+                               parameters: $0.parameters,
+                               timestamp: $0.timestamp,
+                               sampleRate: $0.sampleRate,
+                               requiresPrivacy: $0.requiresPrivacy,
+                               contextVersion: $0.contextVersion)
+            }, batchID: UUID().uuidString)
+            return
+        }
+        pipeline.append(contentsOf: events)
+    }
+    
+    private static func staticContextAttributes() -> [String: Any] {
+        let appVersion = Bundle.main.object(forInfoDictionaryKey: "CFBundleShortVersionString") as? String ?? "unknown"
+        return [
+            AnalyticsProperties.DEVICE_INFO: [
+                "model": UIDevice.current.model,
+                "systemVersion": UIDevice.current.systemVersion,
+                "appVersion": appVersion
+            ],
+            AnalyticsProperties.APP_VERSION: appVersion
         ]
     }
     
     private func setupNetworkMonitoring() {
         networkMonitor = NWPathMonitor()
         networkMonitor?.pathUpdateHandler = { [weak self] path in
-            if path.status == .satisfied {
-                self?.processEventQueue()
+            // Through the ingest queue, like user properties, so ring events keep their network status
+            self?.ingestQueue.async {
+                guard let self = self else { return }
+                self.drainEventRing()
+                guard self.context.setNetworkConnected(path.status == .satisfied) else { return }
+                self.pipeline?.setOnline(path.status == .satisfied)
             }
         }
         networkMonitor?.start(queue: DispatchQueue.global())
     }
     
-    private func enrichEventParameters(_ parameters: [String: Any]?) -> [String: Any] {
+    /// Full context for errors sent on their own rather than as part of a batch
+    func enrichEventParameters(_ parameters: [String: Any]?) -> [String: Any] {
         var enrichedParams = parameters ?? [:]
-        enrichedParams.merge(userProperties) { current, _ in current }
-        enrichedParams[AnalyticsProperties.APP_VERSION] = Bundle.main.object(forInfoDictionaryKey: "CFBundleShortVersionString") as? String ?? "unknown"
-        enrichedParams[AnalyticsProperties.NETWORK_STATUS] = isNetworkAvailable() ? "connected" : "offline"
+        enrichedParams.merge(context.snapshot().attributes) { current, _ in current }
         return enrichedParams
     }
     
+    /// Per-event parameters only; the session context, network status included, is attached from
+    /// the version the event is stamped with
+    func eventParameters(_ parameters: [String: Any], requiresPrivacy: Bool) -> [String: Any] {
+        return requiresPrivacy ? privacyManager.filterSensitiveData(from: parameters) : parameters
+    }
+    
+    /// Reports what shaping dropped since the last summary, so dashboards can rescale counts
+    private func persistSamplingSummaryIfNeeded(at time: CFAbsoluteTime) {
+        guard let summary = samplingSummaryParameters(at: time) else { return }
+        persistEvent(AnalyticsEvents.SAMPLING_SUMMARY, parameters: summary, completion: nil)
+    }
+    
     private func validateEvent(_ eventName: String, parameters: [String: Any]) -> Bool {
         guard !eventName.isEmpty else { return false }
         return true
     }
     
     private func isNetworkAvailable() -> Bool {
-        return networkMonitor?.currentPath.status == .satisfied
+        return context.isNetworkConnected
     }
     
-    private func queueEvent(_ eventName: String, parameters: [String: Any]) {
-        guard eventQueue.count < maxQueueSize else {
-            Logger.shared.error("Event queue full, dropping event: \(eventName)")
-            return
+    /// Low-value, high-frequency events are the first to be sampled when the log backs up
+    private func priority(for eventName: String) -> AnalyticsEventPriority {
+        switch eventName {
+        case AnalyticsEvents.VIEW_PLAYER, AnalyticsEvents.VIEW_TEAM, AnalyticsEvents.UPDATE_LINEUP:
+            return .low
+        case AnalyticsEvents.RUN_SIMULATION, AnalyticsEvents.ANALYZE_TRADE, AnalyticsEvents.SAMPLING_SUMMARY:
+            return .critical
+        default:
+            return eventName.hasPrefix("error_") ? .critical : .normal
         }
-        
-        eventQueue.append((eventName, parameters))
-        Logger.shared.debug("Event queued: \(eventName)")
     }
     
-    private func processEventQueue() {
-        guard !eventQueue.isEmpty else { return }
-        
-        let events = eventQueue
-        eventQueue.removeAll()
-        
-        for (eventName, parameters) in events {
-            sendEvent(eventName, parameters: parameters)
-        }
-        
-        Logger.shared.debug("Processed \(events.count) queued events")
-    }
-    
-    private func sendEvent(_ eventName: String, parameters: [String: Any], retryCount: Int = 0) {
-        var finalParams = parameters
-        finalParams[AnalyticsProperties.RETRY_COUNT] = retryCount
-        
-        RUM.addAttribute(forKey: eventName, value: finalParams)
-        
-        if eventName.starts(with: "error_") {
-            Global.rum.addError(
-                message: parameters[AnalyticsProperties.ERROR_MESSAGE] as? String ?? "Unknown error",
-                source: .custom,
-                attributes: finalParams
-            )
-        } else {
-            Global.rum.addAction(
-                type: .custom,
-                name: eventName,
-                attributes: finalParams
-            )
+    private func persistEvent(
+        _ eventName: String,
+        parameters: [String: Any],
+        requiresPrivacy: Bool = false,
+        sampleRate: Double = 1,
+        completion: ((Error?) -> Void)?
+    ) {
+        let contextVersion = context.snapshot().version
+        guard let pipeline = pipeline else {
+            // Without a writable log, fall back to sending straight away
+            let event = AnalyticsEvent(name: eventName,
+                                       parameters: parameters,
+                                       timestamp: Date(),
+                                       sampleRate: sampleRate,
+                                       requiresPrivacy: requiresPrivacy,
+                                       contextVersion: contextVersion)
+            _ = uploadBatch([event], batchID: UUID().uuidString)
+            completion?(nil)
+            return
         }
+        pipeline.append(eventName,
+                        parameters: parameters,
+                        priority: priority(for: eventName),
+                        requiresPrivacy: requiresPrivacy,
+                        sampleRate: sampleRate,
+                        contextVersion: contextVersion,
+                        completion: completion)
     }
-    
-    private func sendError(_ errorName: String, parameters: [String: Any]) {
-        Global.rum.addError(
-            message: parameters[AnalyticsProperties.ERROR_MESSAGE] as? String ?? errorName,
-            source: .custom,
-            attributes: parameters
-        )
-    }
-}
\ No newline at end of file
+}
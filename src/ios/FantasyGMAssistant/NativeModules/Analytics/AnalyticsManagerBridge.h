@@ -50,7 +50,6 @@ extern NSInteger const ERROR_CODE_INTEGRATION;
 @interface AnalyticsManagerBridge : NSObject <RCTBridgeModule>
 
 // MARK: - Properties
-@property (nonatomic, strong) NSOperationQueue *eventQueue;
 @property (nonatomic, strong) NSUserDefaults *privacySettings;
 
 // MARK: - Event Tracking Methods
@@ -91,6 +90,12 @@ RCT_EXTERN_METHOD(trackError:(NSString *)errorName
  */
 RCT_EXTERN_METHOD(syncOfflineEvents)
 
+/**
+ * Replaces the per-event sampling and rate-limit rules, typically from remote config
+ * @param rules Event name to {sample_rate, rate_per_second, burst}; omitted events are sent in full
+ */
+RCT_EXTERN_METHOD(updateSamplingRules:(NSDictionary *)rules)
+
 // MARK: - Module Constants
 /**
  * Provides constants to React Native layer
@@ -0,0 +1,252 @@
+//
+// AnalyticsPipeline.swift
+// FantasyGMAssistant
+//
+// Persisted analytics pipeline that uploads events in batches triggered by count, size or age
+// Version: 1.0.0
+//
+
+import Foundation // iOS 14.0+
+
+// MARK: - Event Priority
+/// How much an event is worth keeping while the log is backed up. `.critical` events are never sampled.
+public enum AnalyticsEventPriority: Int, CaseIterable {
+    case low = 0
+    case normal = 1
+    case critical = 2
+}
+
+// MARK: - Pipeline Policy
+public struct AnalyticsPipelinePolicy {
+    /// Flush once this many events are pending
+    public var maxBatchCount = 50
+    /// Flush once pending events reach this many encoded bytes; also caps the size of one upload
+    public var maxBatchBytes = 64 * 1024
+    /// Flush pending events no later than this long after the first of them was tracked
+    public var maxBatchAge: TimeInterval = 30
+    /// Log size at which backpressure sampling reaches its floor
+    public var maxLogBytes = 4 * 1024 * 1024
+    
+    public init() {}
+    
+    /// Keeps one in every N events of `priority` once the log is `fill` (pending / max bytes) full
+    public func sampleInterval(for priority: AnalyticsEventPriority, fill: Double) -> Int {
+        let stage = fill < 0.5 ? 0 : fill < 0.75 ? 1 : fill < 1 ? 2 : 3
+        switch (priority, stage) {
+        case (.critical, _), (.normal, 0), (.normal, 1), (.low, 0): return 1
+        case (.normal, 2): return 2
+        case (.low, 1): return 4
+        case (.normal, _), (.low, 2): return 10
+        case (.low, _): return 50
+        }
+    }
+}
+
+// MARK: - Pipeline Stats
+public struct AnalyticsPipelineStats {
+    public internal(set) var pendingEvents = 0
+    public internal(set) var pendingBytes = 0
+    public internal(set) var uploadedEvents = 0
+    public internal(set) var uploadedBatches = 0
+    /// Events dropped by backpressure sampling; kept events carry their sample rate instead
+    public internal(set) var sampledOutEvents = 0
+}
+
+// MARK: - Analytics Pipeline
+/// Persists every tracked event to an append-only log, then uploads pending events in batches
+/// while online. Delivery is at-least-once: a batch uploaded just before the app is killed may
+/// be sent again on the next launch.
+final class AnalyticsPipeline {
+    /// Uploads one batch and returns whether it was accepted; rejected batches stay in the log
+    typealias Uploader = (_ events: [AnalyticsEvent], _ batchID: String) -> Bool
+    
+    /// An event handed to the pipeline but not yet sampled or persisted
+    struct PendingEvent {
+        let name: String
+        let parameters: [String: Any]
+        let priority: AnalyticsEventPriority
+        let timestamp: Date
+        var requiresPrivacy = false
+        /// Share already kept by per-event shaping; combined with backpressure sampling on persist
+        var sampleRate: Double = 1
+        var contextVersion = 0
+    }
+    
+    private let queue = DispatchQueue(label: "com.fantasygm.analytics.pipeline", qos: .utility)
+    private let log: AnalyticsEventLog
+    private var policy: AnalyticsPipelinePolicy
+    private let uploader: Uploader
+    private var sampleCounters: [AnalyticsEventPriority: Int] = [:]
+    private var stats = AnalyticsPipelineStats()
+    private var isOnline = false
+    private var isAgeFlushScheduled = false
+    
+    init?(directory: URL, policy: AnalyticsPipelinePolicy = AnalyticsPipelinePolicy(), uploader: @escaping Uploader) {
+        guard let log = AnalyticsEventLog(directory: directory) else { return nil }
+        self.log = log
+        self.policy = policy
+        self.uploader = uploader
+        
+        if log.pendingCount > 0 {
+            Logger.shared.debug("Recovered \(log.pendingCount) pending analytics events")
+        }
+    }
+    
+    // MARK: - Public Methods
+    /// Persists the event, sampling lower-priority events while the log is backed up.
+    /// The completion is called once the event is on disk, or with the error that kept it off.
+    func append(_ name: String,
+                parameters: [String: Any],
+                priority: AnalyticsEventPriority,
+                requiresPrivacy: Bool = false,
+                sampleRate: Double = 1,
+                contextVersion: Int = 0,
+                completion: ((Error?) -> Void)? = nil) {
+        let event = PendingEvent(name: name,
+                                 parameters: parameters,
+                                 priority: priority,
+                                 timestamp: Date(),
+                                 requiresPrivacy: requiresPrivacy,
+                                 sampleRate: sampleRate,
+                                 contextVersion: contextVersion)
+        queue.async { [weak self] in
+            guard let self = self else { return }
+            let error = self.persist(event)
+            completion?(error)
+            self.flushIfNeeded()
+        }
+    }
+    
+    /// Persists several events with a single hop onto the pipeline queue
+    func append(contentsOf events: [PendingEvent]) {
+        guard !events.isEmpty else { return }
+        queue.async { [weak self] in
+            guard let self = self else { return }
+            events.forEach { _ = self.persist($0) }
+            self.flushIfNeeded()
+        }
+    }
+    
+    /// Applies from the next age flush scheduled; one already pending keeps its deadline
+    func setMaxBatchAge(_ maxBatchAge: TimeInterval) {
+        queue.async { [weak self] in
+            self?.policy.maxBatchAge = maxBatchAge
+        }
+    }
+    
+    /// Uploads are only attempted while online; going online drains the backlog
+    func setOnline(_ online: Bool) {
+        queue.async { [weak self] in
+            guard let self = self else { return }
+            self.isOnline = online
+            if online {
+                self.drain()
+            }
+        }
+    }
+    
+    /// Uploads every pending event now, reporting how many were uploaded and how many remain
+    func flush(completion: ((_ uploaded: Int, _ remaining: Int) -> Void)? = nil) {
+        queue.async { [weak self] in
+            guard let self = self else { return }
+            let uploaded = self.drain()
+            completion?(uploaded, self.log.pendingCount)
+        }
+    }
+    
+    /// Drops every pending event without uploading it
+    func removeAll() {
+        queue.async { [weak self] in
+            self?.log.removeAll()
+        }
+    }
+    
+    var currentStats: AnalyticsPipelineStats {
+        return queue.sync {
+            var snapshot = stats
+            snapshot.pendingEvents = log.pendingCount
+            snapshot.pendingBytes = log.pendingBytes
+            return snapshot
+        }
+    }
+    
+    // MARK: - Private Methods
+    /// Runs on `queue`. Samples the event against the current log fill, then appends it if kept.
+    private func persist(_ pending: PendingEvent) -> Error? {
+        let fill = Double(log.pendingBytes) / Double(policy.maxLogBytes)
+        let interval = policy.sampleInterval(for: pending.priority, fill: fill)
+        let sequence = sampleCounters[pending.priority, default: 0]
+        sampleCounters[pending.priority] = sequence &+ 1
+        
+        guard sequence % interval == 0 else {
+            stats.sampledOutEvents += 1
+            return nil
+        }
+        
+        let event = AnalyticsEvent(name: pending.name,
+                                   parameters: pending.parameters,
+                                   timestamp: pending.timestamp,
+                                   sampleRate: pending.sampleRate / Double(interval),
+                                   requiresPrivacy: pending.requiresPrivacy,
+                                   contextVersion: pending.contextVersion)
+        do {
+            try log.append(event)
+            return nil
+        } catch {
+            Logger.shared.error("Failed to persist analytics event: \(pending.name)", error: error)
+            return error
+        }
+    }
+    
+    /// Runs on `queue`. Flushes once a batch is full, otherwise makes sure an age flush is pending.
+    private func flushIfNeeded() {
+        if log.pendingCount >= policy.maxBatchCount || log.pendingBytes >= policy.maxBatchBytes {
+            drain()
+            return
+        }
+        
+        guard !isAgeFlushScheduled else { return }
+        isAgeFlushScheduled = true
+        queue.asyncAfter(deadline: .now() + policy.maxBatchAge) { [weak self] in
+            guard let self = self else { return }
+            self.isAgeFlushScheduled = false
+            self.drain()
+        }
+    }
+    
+    /// Runs on `queue`. Uploads batch by batch until the log is empty or an upload is rejected,
+    /// returning the number of events uploaded.
+    @discardableResult
+    private func drain() -> Int {
+        guard isOnline else { return 0 }
+        
+        var uploaded = 0
+        while log.pendingCount > 0 {
+            let batch: AnalyticsLogBatch
+            do {
+                batch = try log.readBatch(maxCount: policy.maxBatchCount, maxBytes: policy.maxBatchBytes)
+            } catch {
+                Logger.shared.error("Failed to read analytics event log", error: error)
+                break
+            }
+            guard batch.recordCount > 0 else { break }
+            
+            if !batch.events.isEmpty {
+                guard uploader(batch.events, UUID().uuidString) else {
+                    Logger.shared.error("Analytics batch upload rejected; \(log.pendingCount) events kept", error: nil)
+                    break
+                }
+                stats.uploadedBatches += 1
+            }
+            
+            log.acknowledge(batch)
+            uploaded += batch.events.count
+        }
+        
+        stats.uploadedEvents += uploaded
+        if uploaded > 0 {
+            Logger.shared.debug("Uploaded \(uploaded) analytics events")
+        }
+        return uploaded
+    }
+}
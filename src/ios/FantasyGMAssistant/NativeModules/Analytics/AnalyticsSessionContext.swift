@@ -0,0 +1,151 @@
+//
+// AnalyticsSessionContext.swift
+// FantasyGMAssistant
+//
+// Memoized device, app, user and network context attached to analytics batches
+// Version: 1.0.0
+//
+
+import Foundation // iOS 14.0+
+
+// MARK: - Context Constants
+/// Enough for every user or network change between uploads, including a long offline stretch
+private let MAX_RETAINED_SNAPSHOTS = 32
+
+// MARK: - Session Context
+/// Attributes shared by every event in a session. The merged dictionary is built once and only
+/// rebuilt after user properties or network status actually change, so events carry no copy of it.
+/// Events record the version current when they were tracked, and the uploader attaches that
+/// version's snapshot once per group of events, so a batch uploaded later still reports the user
+/// and network status each event was tracked under.
+final class AnalyticsSessionContext {
+    struct Snapshot {
+        /// Bumped on every rebuild and never reused, across launches too when a history file is kept
+        let version: Int
+        let attributes: [String: Any]
+        /// `attributes` after privacy filtering, attached to events tracked with `requiresPrivacy`
+        let filteredAttributes: [String: Any]
+    }
+    
+    private let lock = NSLock()
+    private let staticAttributes: [String: Any]
+    private let networkStatusKey: String
+    private let privacyFilter: ([String: Any]) -> [String: Any]
+    private var userProperties: [String: Any] = [:]
+    private var isConnected = false
+    private var version = 0
+    private var cached: Snapshot?
+    private var history: [Int: Snapshot] = [:]
+    private let historyURL: URL?
+    
+    /// - Parameters:
+    ///   - staticAttributes: Device and app attributes that never change during a session
+    ///   - networkStatusKey: Attribute under which the current network status is reported
+    ///   - historyURL: Where recent snapshots are kept for events uploaded after a relaunch
+    ///   - privacyFilter: Applied once per rebuild to produce `filteredAttributes`
+    init(staticAttributes: [String: Any],
+         networkStatusKey: String,
+         historyURL: URL? = nil,
+         privacyFilter: @escaping ([String: Any]) -> [String: Any]) {
+        self.staticAttributes = staticAttributes
+        self.networkStatusKey = networkStatusKey
+        self.historyURL = historyURL
+        self.privacyFilter = privacyFilter
+        
+        restoreHistory()
+    }
+    
+    var isNetworkConnected: Bool {
+        lock.lock()
+        defer { lock.unlock() }
+        return isConnected
+    }
+    
+    // MARK: - Updates
+    func setUserProperties(_ properties: [String: Any]) {
+        lock.lock()
+        defer { lock.unlock() }
+        
+        userProperties = properties
+        cached = nil
+    }
+    
+    /// Returns true when the status changed. Path updates that keep the status leave the cache intact.
+    @discardableResult
+    func setNetworkConnected(_ connected: Bool) -> Bool {
+        lock.lock()
+        defer { lock.unlock() }
+        
+        guard connected != isConnected else { return false }
+        isConnected = connected
+        cached = nil
+        return true
+    }
+    
+    // MARK: - Snapshot
+    func snapshot() -> Snapshot {
+        lock.lock()
+        defer { lock.unlock() }
+        
+        if let cached = cached {
+            return cached
+        }
+        
+        // Static attributes win over user properties, matching the old per-event merge order
+        var attributes = userProperties
+        attributes.merge(staticAttributes) { _, fixed in fixed }
+        attributes[networkStatusKey] = isConnected ? "connected" : "offline"
+        
+        version += 1
+        let snapshot = Snapshot(version: version, attributes: attributes, filteredAttributes: privacyFilter(attributes))
+        cached = snapshot
+        retain(snapshot)
+        return snapshot
+    }
+    
+    /// The snapshot events stamped with `version` were tracked under, or nil once it has aged out
+    func snapshot(version: Int) -> Snapshot? {
+        lock.lock()
+        defer { lock.unlock() }
+        return history[version]
+    }
+    
+    // MARK: - History
+    /// Called with `lock` held after every rebuild; rebuilds are rare, so the file is rewritten each time
+    private func retain(_ snapshot: Snapshot) {
+        history[snapshot.version] = snapshot
+        if history.count > MAX_RETAINED_SNAPSHOTS, let oldest = history.keys.min() {
+            history[oldest] = nil
+        }
+        
+        guard let historyURL = historyURL else { return }
+        let stored = Dictionary(uniqueKeysWithValues: history.map { (String($0.key), $0.value.attributes) })
+        guard JSONSerialization.isValidJSONObject(stored),
+              let data = try? JSONSerialization.data(withJSONObject: stored) else {
+            Logger.shared.debug("Analytics context history not persisted; attributes are not JSON")
+            return
+        }
+        do {
+            try data.write(to: historyURL, options: .atomic)
+        } catch {
+            Logger.shared.error("Failed to persist analytics context history", error: error)
+        }
+    }
+    
+    /// Versions continue from the newest stored snapshot so persisted events never match a new one
+    private func restoreHistory() {
+        guard let historyURL = historyURL,
+              let data = try? Data(contentsOf: historyURL),
+              let stored = (try? JSONSerialization.jsonObject(with: data)) as? [String: [String: Any]] else {
+            return
+        }
+        
+        for (key, attributes) in stored {
+            guard let storedVersion = Int(key) else { continue }
+            history[storedVersion] = Snapshot(version: storedVersion,
+                                              attributes: attributes,
+                                              filteredAttributes: privacyFilter(attributes))
+        }
+        version = history.keys.max() ?? 0
+    }
+}
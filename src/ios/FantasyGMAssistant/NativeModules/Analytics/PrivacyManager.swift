@@ -0,0 +1,287 @@
+//
+// PrivacyManager.swift
+// FantasyGMAssistant
+//
+// PII masking for analytics parameters using per-level compiled key rules and cached masked values
+// Version: 1.0.0
+//
+
+import Foundation // iOS 14.0+
+import CryptoKit // iOS 13.0+
+
+// MARK: - Privacy Constants
+/// Bytes of input and output kept by each of the pseudonym and scrubbed text caches
+private let MASKED_VALUE_CACHE_BYTES = 256 * 1024
+/// Longer free text, such as a stack trace, is scrubbed every time instead of crowding out the cache
+private let MAX_CACHED_TEXT_BYTES = 4 * 1024
+/// Distinct parameter names classified per privacy level before the least recent are reclassified
+private let CLASSIFIED_KEY_LIMIT = 1024
+private let PSEUDONYM_SALT_KEY = "analytics_pseudonym_salt"
+private let PII_MASKED_KEY = "pii_masked"
+private let PRIVACY_LEVEL_KEY = "privacy_level"
+
+// MARK: - Privacy Configuration
+public enum PrivacyLevel: Int, CaseIterable {
+    /// Drops contact details and secrets, and scrubs PII out of free text
+    case standard = 0
+    /// Also pseudonymizes account identifiers and redacts names
+    case strict = 1
+    /// Also drops free text entirely
+    case minimal = 2
+}
+
+public struct PrivacyConfig {
+    public var gdprEnabled: Bool
+    public var level: PrivacyLevel
+    
+    public init(gdprEnabled: Bool = false, level: PrivacyLevel = .standard) {
+        self.gdprEnabled = gdprEnabled
+        self.level = level
+    }
+    
+    /// GDPR consent flows require at least pseudonymous identifiers
+    var effectiveLevel: PrivacyLevel {
+        return gdprEnabled && level == .standard ? .strict : level
+    }
+}
+
+// MARK: - Privacy Rules
+enum PrivacyAction: Equatable {
+    case keep
+    case drop
+    case redact(String)
+    /// Replaced with a stable salted hash so events can still be joined per user or team
+    case pseudonymize
+    /// Free text; known PII patterns inside the value are replaced
+    case scan
+}
+
+/// Key fragments matched against whole `_`-separated segments of parameter names, so `ssn` does not
+/// match `classname` nor `token` `tokens_remaining`. Checked in order; first match wins.
+/// Every drop rule comes first, so a level's drop is never shadowed by a weaker action matched
+/// earlier on another fragment of the same key (`error_message` is dropped at `.minimal`).
+private let PRIVACY_KEY_RULES: [(fragment: String, minimumLevel: PrivacyLevel, action: PrivacyAction)] = [
+    ("message", .minimal, .drop),
+    ("comment", .minimal, .drop),
+    ("query", .minimal, .drop),
+    ("password", .standard, .drop),
+    ("token", .standard, .drop),
+    ("secret", .standard, .drop),
+    ("ssn", .standard, .drop),
+    ("email", .standard, .redact("[EMAIL]")),
+    ("phone", .standard, .redact("[PHONE]")),
+    ("mobile", .standard, .redact("[PHONE]")),
+    ("address", .standard, .drop),
+    ("street", .standard, .drop),
+    ("postal", .standard, .drop),
+    ("zip", .standard, .drop),
+    ("user_id", .strict, .pseudonymize),
+    ("team_id", .strict, .pseudonymize),
+    ("device_id", .strict, .pseudonymize),
+    ("first_name", .strict, .redact("[NAME]")),
+    ("last_name", .strict, .redact("[NAME]")),
+    ("full_name", .strict, .redact("[NAME]")),
+    ("display_name", .strict, .redact("[NAME]")),
+    ("username", .strict, .redact("[NAME]")),
+    ("user_name", .strict, .redact("[NAME]")),
+    ("error_message", .standard, .scan),
+    ("message", .standard, .scan),
+    ("comment", .standard, .scan),
+    ("query", .standard, .scan),
+    ("note", .standard, .scan)
+]
+
+/// Keys the app sends constantly that never carry PII; checked before the table so they skip
+/// classification entirely and never take one of its slots
+private let PRIVACY_SAFE_KEYS: Set<String> = [
+    "sport_type", "is_premium", "feature_name", "duration_ms", "error_type", "error_code",
+    "app_version", "network_status", "retry_count", "batch_id", "sample_rate", "device_info",
+    "model", "systemVersion", "appVersion"
+]
+
+/// Leading segments of boolean flags such as `is_mobile`, which say nothing about the user's data
+private let PRIVACY_FLAG_PREFIXES = ["_is_", "_has_"]
+
+private let PII_TEXT_PATTERNS: [(regex: NSRegularExpression, replacement: String)] = [
+    ("\\b[A-Z0-9._%+-]+@[A-Z0-9.-]+\\.[A-Z]{2,}\\b", "[EMAIL]"),
+    ("\\b\\d{3}-\\d{2}-\\d{4}\\b", "[SSN]"),
+    ("\\b\\d{3}[-.]?\\d{3}[-.]?\\d{4}\\b", "[PHONE]")
+].compactMap { pattern, replacement in
+    guard let regex = try? NSRegularExpression(pattern: pattern, options: [.caseInsensitive]) else { return nil }
+    return (regex, replacement)
+}
+
+/// Key-to-action table for one privacy level. Unknown keys are classified once, then served
+/// from the table, so the per-key cost does not depend on how many rules there are. Parameter
+/// names come from JS as well, so the table is an LRU rather than growing with every new name.
+struct PrivacyRuleTable {
+    let level: PrivacyLevel
+    private let actions = CacheLRU<PrivacyAction>(costLimit: CLASSIFIED_KEY_LIMIT)
+    
+    init(level: PrivacyLevel) {
+        self.level = level
+    }
+    
+    func action(for key: String) -> PrivacyAction {
+        if PRIVACY_SAFE_KEYS.contains(key) {
+            return .keep
+        }
+        if let action = actions.value(forKey: key) {
+            return action
+        }
+        
+        let segmented = PrivacyRuleTable.segmented(key)
+        let action: PrivacyAction
+        if PRIVACY_FLAG_PREFIXES.contains(where: { segmented.hasPrefix($0) }) {
+            action = .keep
+        } else {
+            action = PRIVACY_KEY_RULES.first { rule in
+                rule.minimumLevel.rawValue <= level.rawValue && segmented.contains("_\(rule.fragment)_")
+            }?.action ?? .keep
+        }
+        actions.insert(action, forKey: key, cost: 1)
+        return action
+    }
+    
+    /// Lowercased with `_` around every segment: `firstName`, `first-name` and `First_Name` all
+    /// become `_first_name_`
+    static func segmented(_ key: String) -> String {
+        var result = "_"
+        var previousIsLowercase = false
+        for character in key {
+            if character == "_" || character == "-" || character == "." || character == " " {
+                if result.last != "_" {
+                    result.append("_")
+                }
+                previousIsLowercase = false
+                continue
+            }
+            if character.isUppercase && previousIsLowercase {
+                result.append("_")
+            }
+            result.append(contentsOf: character.lowercased())
+            previousIsLowercase = character.isLowercase || character.isNumber
+        }
+        if result.last != "_" {
+            result.append("_")
+        }
+        return result
+    }
+}
+
+// MARK: - Privacy Manager
+/// Masks PII in analytics parameters. Dictionaries with nothing to mask are returned as-is
+/// without copying, and pseudonyms and scrubbed text are cached for repeated identical values.
+final class PrivacyManager {
+    private let lock = NSLock()
+    private var tables: [PrivacyLevel: PrivacyRuleTable] = [:]
+    private var level: PrivacyLevel = .standard
+    private let pseudonyms = CacheLRU<String>(costLimit: MASKED_VALUE_CACHE_BYTES)
+    private let scrubbedText = CacheLRU<String>(costLimit: MASKED_VALUE_CACHE_BYTES)
+    private lazy var pseudonymKey = PrivacyManager.loadPseudonymKey()
+    
+    func configure(with config: PrivacyConfig) {
+        lock.lock()
+        defer { lock.unlock() }
+        
+        level = config.effectiveLevel
+        Logger.shared.debug("Analytics privacy level set to \(level.rawValue)")
+    }
+    
+    func filterSensitiveData(from parameters: [String: Any]) -> [String: Any] {
+        lock.lock()
+        defer { lock.unlock() }
+        
+        let table = tables[level] ?? PrivacyRuleTable(level: level)
+        tables[level] = table
+        
+        guard let filtered = filter(parameters, table: table) else {
+            return parameters
+        }
+        
+        var result = filtered
+        result[PII_MASKED_KEY] = true
+        result[PRIVACY_LEVEL_KEY] = level.rawValue
+        return result
+    }
+    
+    // MARK: - Private Methods
+    /// Must hold `lock`. Returns nil when nothing needed masking, so the caller can keep the input.
+    private func filter(_ parameters: [String: Any], table: PrivacyRuleTable) -> [String: Any]? {
+        var result: [String: Any]?
+        
+        for (key, value) in parameters {
+            let replacement: Any?
+            switch table.action(for: key) {
+            case .keep:
+                guard let nested = value as? [String: Any], let filtered = filter(nested, table: table) else {
+                    continue
+                }
+                replacement = filtered
+            case .drop:
+                replacement = nil
+            case .redact(let token):
+                replacement = token
+            case .pseudonymize:
+                replacement = pseudonym(for: String(describing: value))
+            case .scan:
+                guard let text = value as? String else { continue }
+                let scrubbed = scrub(text)
+                guard scrubbed != text else { continue }
+                replacement = scrubbed
+            }
+            
+            // Copy on the first change only
+            if result == nil {
+                result = parameters
+            }
+            result?[key] = replacement
+        }
+        
+        return result
+    }
+    
+    private func pseudonym(for value: String) -> String {
+        if let cached = pseudonyms.value(forKey: value) {
+            return cached
+        }
+        
+        let digest = HMAC<SHA256>.authenticationCode(for: Data(value.utf8), using: pseudonymKey)
+        let pseudonym = "p_" + digest.prefix(8).map { String(format: "%02x", $0) }.joined()
+        pseudonyms.insert(pseudonym, forKey: value, cost: value.utf8.count + pseudonym.utf8.count)
+        return pseudonym
+    }
+    
+    private func scrub(_ text: String) -> String {
+        if let cached = scrubbedText.value(forKey: text) {
+            return cached
+        }
+        
+        var scrubbed = text
+        for pattern in PII_TEXT_PATTERNS {
+            scrubbed = pattern.regex.stringByReplacingMatches(
+                in: scrubbed,
+                options: [],
+                range: NSRange(location: 0, length: scrubbed.utf16.count),
+                withTemplate: pattern.replacement
+            )
+        }
+        let cost = text.utf8.count + scrubbed.utf8.count
+        if cost <= MAX_CACHED_TEXT_BYTES {
+            scrubbedText.insert(scrubbed, forKey: text, cost: cost)
+        }
+        return scrubbed
+    }
+    
+    /// Per-install salt so pseudonyms are stable across launches but not comparable across devices
+    private static func loadPseudonymKey() -> SymmetricKey {
+        let defaults = UserDefaults.standard
+        if let salt = defaults.data(forKey: PSEUDONYM_SALT_KEY), salt.count == 32 {
+            return SymmetricKey(data: salt)
+        }
+        
+        let key = SymmetricKey(size: .bits256)
+        defaults.set(key.withUnsafeBytes { Data($0) }, forKey: PSEUDONYM_SALT_KEY)
+        return key
+    }
+}
@@ -0,0 +1,103 @@
+//
+// AuthRateLimiter.swift
+// FantasyGMAssistant
+//
+// Lock-free, fixed-size per-identifier token buckets for sign-in attempts
+// Version: 1.0.0
+//
+
+import Foundation // iOS 14.0+
+
+// MARK: - Limiter Constants
+/// Power of two; 8KB of buckets tracks far more identifiers than one device ever signs in with
+private let RATE_LIMITER_SLOTS = 1024
+/// Slots searched from an identifier's home slot before giving up
+private let RATE_LIMITER_PROBES = 8
+private let TAG_SHIFT: UInt64 = 48
+private let TIME_MASK: UInt64 = (1 << TAG_SHIFT) - 1
+
+// MARK: - Auth Rate Limiter
+/// A token bucket per identifier, each packed into one 64-bit word and updated with a single
+/// compare-and-swap, so checks never block or hop queues. A word holds a 16-bit tag of the
+/// identifier's hash and the time in milliseconds at which its bucket will be full again (the
+/// generic cell rate algorithm). A full bucket carries no state, so once that time passes the
+/// slot is free for any identifier; stale entries are pruned simply by being reused, and the
+/// table never grows. Identifiers whose tags collide share a bucket, which only errs strict.
+final class AuthRateLimiter {
+    private let slots: UnsafeMutablePointer<UInt64>
+    private let mask: Int
+    /// Milliseconds each attempt takes from the bucket
+    private let emissionInterval: UInt64
+    /// How far ahead of now a bucket may be drawn down: `burst` attempts' worth
+    private let tolerance: UInt64
+    private let startTime = AuthRateLimiter.monotonicMilliseconds()
+    
+    /// Allows `burst` attempts at once, then refills one attempt every `window / burst` seconds
+    init(burst: Int, window: TimeInterval) {
+        slots = .allocate(capacity: RATE_LIMITER_SLOTS)
+        slots.initialize(repeating: 0, count: RATE_LIMITER_SLOTS)
+        mask = RATE_LIMITER_SLOTS - 1
+        emissionInterval = UInt64(max(1, window * 1000 / Double(max(1, burst))))
+        tolerance = emissionInterval * UInt64(max(1, burst))
+    }
+    
+    deinit {
+        slots.deallocate()
+    }
+    
+    // MARK: - Checks
+    /// Takes one attempt from the identifier's bucket. Returns false, taking nothing, when empty.
+    func allow(_ identifier: String) -> Bool {
+        // Offset by one interval so untouched slots, which hold zero, always read as full
+        let now = Self.monotonicMilliseconds() - startTime + emissionInterval
+        let hash = UInt64(bitPattern: Int64(identifier.hashValue))
+        let tag = hash >> TAG_SHIFT
+        let home = Int(truncatingIfNeeded: hash) & mask
+        
+        // The identifier's own live bucket wins over a free slot earlier in the probe sequence
+        let probes = (0..<RATE_LIMITER_PROBES).map { (home + $0) & mask }
+        let owned = probes.first { fgm_atomic_load_relaxed(slots + $0) >> TAG_SHIFT == tag }
+        for slot in owned.map({ [$0] + probes }) ?? probes {
+            if let allowed = take(from: slot, tag: tag, now: now) {
+                return allowed
+            }
+        }
+        
+        // Every nearby slot holds another identifier's live bucket; fail open rather than lock out
+        Logger.shared.debug("Sign-in rate limiter is full, allowing attempt untracked")
+        return true
+    }
+    
+    /// Forgets every identifier's attempts
+    func reset() {
+        for slot in 0..<RATE_LIMITER_SLOTS {
+            fgm_atomic_store_relaxed(slots + slot, 0)
+        }
+    }
+    
+    // MARK: - Private Methods
+    /// nil when the slot belongs to another identifier whose bucket is not yet full
+    private func take(from slot: Int, tag: UInt64, now: UInt64) -> Bool? {
+        var current = fgm_atomic_load_relaxed(slots + slot)
+        while true {
+            let isOwned = current >> TAG_SHIFT == tag
+            let fullAt = current & TIME_MASK
+            if !isOwned && fullAt > now {
+                return nil
+            }
+            
+            let drawnTo = (isOwned ? max(fullAt, now) : now) + emissionInterval
+            if drawnTo - now > tolerance {
+                return false
+            }
+            if fgm_atomic_compare_exchange_relaxed(slots + slot, &current, tag << TAG_SHIFT | drawnTo) {
+                return true
+            }
+        }
+    }
+    
+    /// Counts through sleep, unlike system uptime, so buckets refill while the device is locked
+    private static func monotonicMilliseconds() -> UInt64 {
+        return clock_gettime_nsec_np(CLOCK_MONOTONIC) / 1_000_000
+    }
+}
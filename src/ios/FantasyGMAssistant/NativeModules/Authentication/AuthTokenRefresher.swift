@@ -0,0 +1,148 @@
+//
+// AuthTokenRefresher.swift
+// FantasyGMAssistant
+//
+// Proactive, deduplicated ID token refresh ahead of expiry
+// Version: 1.0.0
+//
+
+import Foundation // iOS 14.0+
+import UIKit // iOS 14.0+
+
+// MARK: - Refresh Constants
+/// Tokens are refreshed this long before they expire
+private let TOKEN_REFRESH_LEAD: TimeInterval = 300
+/// Random extra lead so devices that signed in together do not refresh together
+private let TOKEN_REFRESH_JITTER: TimeInterval = 60
+private let TOKEN_RETRY_INTERVAL: TimeInterval = 30
+
+typealias AuthTokenFetch = (@escaping (Result<AuthToken, Error>) -> Void) -> Void
+
+// MARK: - Auth Token Refresher
+/// Keeps `AuthTokenStore` filled with a token that has time left. A wall-clock timer refreshes
+/// ahead of expiry with jitter, and returning to the foreground refreshes straight away if the
+/// timer came due while suspended, so the first requests after a resume read a fresh token.
+/// Concurrent refresh requests share one in-flight fetch. State is confined to `queue`.
+final class AuthTokenRefresher {
+    private let store: AuthTokenStore
+    private let queue: DispatchQueue
+    private let fetch: AuthTokenFetch
+    private let jitter: () -> TimeInterval
+    private var waiters: [(Result<AuthToken, Error>) -> Void] = []
+    private var isFetching = false
+    private var timer: DispatchSourceTimer?
+    private var expirationDate: Date?
+    /// Bumped on sign-out so a fetch that was in flight does not publish its token
+    private var generation = 0
+    private var foregroundObserver: NSObjectProtocol?
+    
+    /// - Parameters:
+    ///   - fetch: Forces a token refresh and calls back once, on any thread
+    ///   - jitter: Extra refresh lead in seconds, random up to a minute by default
+    init(store: AuthTokenStore = .shared,
+         queue: DispatchQueue,
+         jitter: @escaping () -> TimeInterval = { TimeInterval.random(in: 0...TOKEN_REFRESH_JITTER) },
+         fetch: @escaping AuthTokenFetch) {
+        self.store = store
+        self.queue = queue
+        self.jitter = jitter
+        self.fetch = fetch
+        
+        foregroundObserver = NotificationCenter.default.addObserver(
+            forName: UIApplication.willEnterForegroundNotification,
+            object: nil,
+            queue: nil
+        ) { [weak self] _ in
+            self?.queue.async { self?.refreshIfDue() }
+        }
+    }
+    
+    deinit {
+        timer?.cancel()
+        foregroundObserver.map { NotificationCenter.default.removeObserver($0) }
+    }
+    
+    // MARK: - Tokens
+    /// Forces a refresh, or joins the one already in flight
+    func refresh(_ completion: ((Result<AuthToken, Error>) -> Void)? = nil) {
+        queue.async {
+            if let completion = completion {
+                self.waiters.append(completion)
+            }
+            guard !self.isFetching else { return }
+            self.isFetching = true
+            
+            let generation = self.generation
+            self.fetch { result in
+                self.queue.async { self.finishFetch(result, generation: generation) }
+            }
+        }
+    }
+    
+    /// Publishes a token obtained elsewhere, such as at sign-in, and schedules its refresh
+    func tokenDidChange(_ token: AuthToken) {
+        queue.async {
+            self.publish(token)
+        }
+    }
+    
+    /// Clears the cached token and stops refreshing, e.g. on sign-out
+    func stop() {
+        queue.async {
+            self.generation += 1
+            self.expirationDate = nil
+            self.timer?.cancel()
+            self.timer = nil
+            self.store.clear()
+        }
+    }
+    
+    // MARK: - Private Methods
+    /// Must run on `queue`
+    private func finishFetch(_ result: Result<AuthToken, Error>, generation: Int) {
+        isFetching = false
+        let completions = waiters
+        waiters.removeAll()
+        
+        switch result {
+        case .success(let token) where generation == self.generation:
+            publish(token)
+        case .success:
+            break
+        case .failure(let error):
+            Logger.shared.error("Token refresh failed", error: error)
+            // Still signed in, so try again before the cached token runs out
+            if expirationDate != nil {
+                schedule(after: TOKEN_RETRY_INTERVAL)
+            }
+        }
+        completions.forEach { $0(result) }
+    }
+    
+    /// Must run on `queue`
+    private func publish(_ token: AuthToken) {
+        store.publish(token)
+        expirationDate = token.expirationDate
+        schedule(after: token.expirationDate.timeIntervalSinceNow - TOKEN_REFRESH_LEAD - jitter())
+    }
+    
+    /// Must run on `queue`. Wall-clock deadlines keep counting while the device sleeps.
+    private func schedule(after delay: TimeInterval) {
+        timer?.cancel()
+        let timer = DispatchSource.makeTimerSource(queue: queue)
+        timer.schedule(wallDeadline: .now() + max(0, delay), leeway: .seconds(1))
+        timer.setEventHandler { [weak self] in
+            self?.timer = nil
+            self?.refresh()
+        }
+        timer.resume()
+        self.timer = timer
+    }
+    
+    /// Must run on `queue`
+    private func refreshIfDue() {
+        guard let expirationDate = expirationDate,
+              expirationDate.timeIntervalSinceNow < TOKEN_REFRESH_LEAD else { return }
+        refresh()
+    }
+}
@@ -0,0 +1,112 @@
+//
+// AuthTokenStore.swift
+// FantasyGMAssistant
+//
+// Lock-free cached ID token for modules that call the backend
+// Version: 1.0.0
+//
+
+import Foundation // iOS 14.0+
+
+// MARK: - Store Constants
+/// Firebase ID tokens run to about 1KB; longer tokens are not cached and readers fall back to a refresh
+private let TOKEN_STORE_CAPACITY = 8192
+private let SEQUENCE_WORD = 0
+private let LENGTH_WORD = 1
+private let EXPIRY_WORD = 2
+private let TOKEN_STORE_WORD_COUNT = 3
+
+// MARK: - Auth Token
+struct AuthToken {
+    let value: String
+    let expirationDate: Date
+}
+
+// MARK: - Auth Token Store
+/// Holds the current user's ID token behind a sequence lock, so reads never block on the auth
+/// queue or a refresh. A writer makes the sequence odd, copies the token into preallocated
+/// storage and makes it even again; a reader copies the token out and retries only if the
+/// sequence moved underneath it. Writes happen about once an hour, so retries are rare.
+final class AuthTokenStore {
+    static let shared = AuthTokenStore()
+    
+    private let words: UnsafeMutablePointer<UInt64>
+    private let bytes: UnsafeMutablePointer<UInt8>
+    /// Serializes writers only
+    private let writeLock = NSLock()
+    
+    init() {
+        words = .allocate(capacity: TOKEN_STORE_WORD_COUNT)
+        words.initialize(repeating: 0, count: TOKEN_STORE_WORD_COUNT)
+        bytes = .allocate(capacity: TOKEN_STORE_CAPACITY)
+        bytes.initialize(repeating: 0, count: TOKEN_STORE_CAPACITY)
+    }
+    
+    deinit {
+        words.deallocate()
+        bytes.deallocate()
+    }
+    
+    // MARK: - Reading
+    /// The cached token if it stays valid for at least `minimumValidity` seconds, otherwise nil.
+    /// Safe from any thread and never blocks.
+    func token(validFor minimumValidity: TimeInterval = 0) -> String? {
+        while true {
+            let sequence = fgm_atomic_load_acquire(words + SEQUENCE_WORD)
+            guard sequence & 1 == 0 else { continue }
+            
+            // The length never exceeds the capacity, so a torn read still stays in bounds
+            let length = Int(fgm_atomic_load_relaxed(words + LENGTH_WORD))
+            let expiry = Double(bitPattern: fgm_atomic_load_relaxed(words + EXPIRY_WORD))
+            let isValid = length > 0 && expiry - Date().timeIntervalSince1970 > minimumValidity
+            let token = isValid
+                ? String(decoding: UnsafeBufferPointer(start: bytes, count: length), as: UTF8.self)
+                : nil
+            
+            fgm_atomic_thread_fence()
+            if fgm_atomic_load_relaxed(words + SEQUENCE_WORD) == sequence {
+                return token
+            }
+        }
+    }
+    
+    // MARK: - Writing
+    /// Returns false, leaving the store empty, when the token does not fit
+    @discardableResult
+    func publish(_ token: AuthToken) -> Bool {
+        let utf8 = Array(token.value.utf8)
+        guard utf8.count <= TOKEN_STORE_CAPACITY else {
+            Logger.shared.error("ID token of \(utf8.count) bytes is too long to cache")
+            clear()
+            return false
+        }
+        
+        write(length: utf8.count, expiry: token.expirationDate.timeIntervalSince1970) {
+            utf8.withUnsafeBufferPointer { source in
+                if let base = source.baseAddress {
+                    bytes.assign(from: base, count: source.count)
+                }
+            }
+        }
+        return true
+    }
+    
+    func clear() {
+        write(length: 0, expiry: 0) {}
+    }
+    
+    // MARK: - Private Methods
+    private func write(length: Int, expiry: TimeInterval, copyBytes: () -> Void) {
+        writeLock.lock()
+        defer { writeLock.unlock() }
+        
+        let sequence = fgm_atomic_load_relaxed(words + SEQUENCE_WORD)
+        fgm_atomic_store_relaxed(words + SEQUENCE_WORD, sequence &+ 1)
+        fgm_atomic_thread_fence()
+        
+        copyBytes()
+        fgm_atomic_store_relaxed(words + LENGTH_WORD, UInt64(length))
+        fgm_atomic_store_relaxed(words + EXPIRY_WORD, expiry.bitPattern)
+        fgm_atomic_store_release(words + SEQUENCE_WORD, sequence &+ 2)
+    }
+}
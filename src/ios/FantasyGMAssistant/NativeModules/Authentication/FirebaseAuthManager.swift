@@ -15,7 +15,6 @@ import CryptoKit // iOS 14.0+
 // MARK: - Constants
 private let AUTH_ERROR_DOMAIN = "com.fantasygm.assistant.auth"
 private let AUTH_QUEUE = DispatchQueue(label: "com.fantasygm.assistant.auth", qos: .userInitiated)
-private let TOKEN_REFRESH_THRESHOLD: TimeInterval = 300 // 5 minutes before expiry
 private let MAX_LOGIN_ATTEMPTS = 5
 private let RATE_LIMIT_RESET: TimeInterval = 300 // 5 minutes
 
@@ -59,15 +58,33 @@ class FirebaseAuthManager: NSObject {
     private var currentUser: User?
     private let authQueue: DispatchQueue
     private var deviceFingerprint: String
-    private var rateLimiter: [String: (attempts: Int, lastAttempt: Date)]
-    private var tokenCache: [String: (token: String, expiry: Date)]
+    /// Checked without blocking from inside `authQueue` work
+    private let rateLimiter: AuthRateLimiter
+    /// Fills `AuthTokenStore.shared`, which other modules read without waiting on this queue
+    private let tokenRefresher: AuthTokenRefresher
     
     // MARK: - Initialization
     override init() {
-        self.auth = Auth.auth()
+        let auth = Auth.auth()
+        self.auth = auth
         self.authQueue = AUTH_QUEUE
-        self.rateLimiter = [:]
-        self.tokenCache = [:]
+        self.rateLimiter = AuthRateLimiter(burst: MAX_LOGIN_ATTEMPTS, window: RATE_LIMIT_RESET)
+        self.tokenRefresher = AuthTokenRefresher(queue: AUTH_QUEUE) { completion in
+            guard let user = auth.currentUser else {
+                completion(.failure(AuthError.userNotFound))
+                return
+            }
+            
+            let span = PerformanceTracer.shared.begin("auth_token_refresh")
+            user.getIDTokenResult(forcingRefresh: true) { (result, error) in
+                PerformanceTracer.shared.end(span, failed: error != nil || result == nil)
+                if let result = result {
+                    completion(.success(AuthToken(value: result.token, expirationDate: result.expirationDate)))
+                } else {
+                    completion(.failure(error ?? AuthError.tokenExpired))
+                }
+            }
+        }
         
         // Generate device fingerprint
         let deviceData = "\(UIDevice.current.identifierForVendor?.uuidString ?? "")\(Bundle.main.bundleIdentifier ?? "")"
@@ -99,7 +116,9 @@ class FirebaseAuthManager: NSObject {
     
     // MARK: - Private Methods
     private func validateSession(_ user: User) {
+        let span = PerformanceTracer.shared.begin("auth_validate_session")
         user.getIDTokenResult(forcingRefresh: false) { [weak self] (result, error) in
+            PerformanceTracer.shared.end(span, failed: error != nil)
             guard let self = self else { return }
             
             if let error = error {
@@ -118,35 +137,22 @@ class FirebaseAuthManager: NSObject {
                 return
             }
             
-            // Check token expiration
-            if result.expirationDate.timeIntervalSinceNow < TOKEN_REFRESH_THRESHOLD {
-                self.refreshToken(nil, nil)
-            }
+            // Refreshes immediately if the token is already close to expiry
+            self.tokenRefresher.tokenDidChange(AuthToken(value: result.token, expirationDate: result.expirationDate))
         }
     }
     
+    /// Safe on any queue, including `authQueue` itself. Addresses differing only in case share a limit.
     private func checkRateLimit(for identifier: String) -> Bool {
-        return authQueue.sync {
-            let now = Date()
-            if let limitData = rateLimiter[identifier] {
-                if limitData.attempts >= MAX_LOGIN_ATTEMPTS {
-                    if now.timeIntervalSince(limitData.lastAttempt) < RATE_LIMIT_RESET {
-                        return false
-                    }
-                    rateLimiter[identifier] = (0, now)
-                }
-                rateLimiter[identifier] = (limitData.attempts + 1, now)
-            } else {
-                rateLimiter[identifier] = (1, now)
-            }
-            return true
-        }
+        return rateLimiter.allow(identifier.lowercased())
+    }
+    
+    @objc private func resetRateLimiter() {
+        rateLimiter.reset()
     }
     
     private func clearTokenCache() {
-        authQueue.async {
-            self.tokenCache.removeAll()
-        }
+        tokenRefresher.stop()
     }
     
     // MARK: - Public Methods
@@ -155,34 +161,43 @@ class FirebaseAuthManager: NSObject {
                               resolve: @escaping RCTPromiseResolveBlock,
                               reject: @escaping RCTPromiseRejectBlock) {
         
+        let tracer = PerformanceTracer.shared
+        let signInSpan = tracer.begin("auth_sign_in")
+        
+        // Rate limiting check; lock-free, so limited attempts are turned away without queueing
+        guard tracer.trace("auth_rate_limit", parent: signInSpan, { checkRateLimit(for: email) }) else {
+            Logger.shared.warning("Rate limit exceeded for email: [EMAIL]")
+            tracer.end(signInSpan, failed: true)
+            reject("\(AuthError.rateLimitExceeded.rawValue)",
+                  AuthError.rateLimitExceeded.localizedDescription,
+                  AuthError.rateLimitExceeded)
+            return
+        }
+        
         authQueue.async {
-            // Rate limiting check
-            guard self.checkRateLimit(for: email) else {
-                Logger.shared.warning("Rate limit exceeded for email: [EMAIL]")
-                reject("\(AuthError.rateLimitExceeded.rawValue)",
-                      AuthError.rateLimitExceeded.localizedDescription,
-                      AuthError.rateLimitExceeded)
-                return
-            }
-            
             // Device trust check
             guard KeychainWrapper.standard.string(forKey: "device_trust_token") != nil else {
                 Logger.shared.error("Untrusted device detected")
+                tracer.end(signInSpan, failed: true)
                 reject("\(AuthError.deviceNotTrusted.rawValue)",
                       AuthError.deviceNotTrusted.localizedDescription,
                       AuthError.deviceNotTrusted)
                 return
             }
             
+            let firebaseSpan = tracer.begin("auth_firebase_sign_in", parent: signInSpan)
             self.auth.signIn(withEmail: email, password: password) { (result, error) in
+                tracer.end(firebaseSpan, failed: error != nil)
                 if let error = error {
                     Logger.shared.error("Sign in failed", error: error)
                     let authError = self.handleAuthError(error)
+                    tracer.end(signInSpan, failed: true)
                     reject("\(authError.rawValue)", authError.localizedDescription, authError)
                     return
                 }
                 
                 guard let user = result?.user else {
+                    tracer.end(signInSpan, failed: true)
                     reject("\(AuthError.userNotFound.rawValue)",
                           AuthError.userNotFound.localizedDescription,
                           AuthError.userNotFound)
@@ -190,19 +205,26 @@ class FirebaseAuthManager: NSObject {
                 }
                 
                 // Get fresh token
+                let tokenSpan = tracer.begin("auth_token_refresh", parent: signInSpan)
                 user.getIDTokenResult(forcingRefresh: true) { (result, error) in
+                    tracer.end(tokenSpan, failed: error != nil)
                     if let error = error {
                         Logger.shared.error("Token retrieval failed", error: error)
+                        tracer.end(signInSpan, failed: true)
                         reject("\(AuthError.tokenExpired.rawValue)",
                               AuthError.tokenExpired.localizedDescription,
                               AuthError.tokenExpired)
                         return
                     }
                     
-                    guard let token = result?.token else { return }
+                    guard let token = result?.token else {
+                        tracer.end(signInSpan, failed: true)
+                        return
+                    }
                     
-                    // Cache token
-                    self.tokenCache[user.uid] = (token, result?.expirationDate ?? Date())
+                    // Cache token and schedule its refresh
+                    self.tokenRefresher.tokenDidChange(AuthToken(value: token,
+                                                                 expirationDate: result?.expirationDate ?? Date()))
                     
                     // Return user data
                     let userData: [String: Any] = [
@@ -214,43 +236,32 @@ class FirebaseAuthManager: NSObject {
                     ]
                     
                     Logger.shared.info("User signed in successfully: \(user.uid)")
+                    tracer.end(signInSpan)
                     resolve(userData)
                 }
             }
         }
     }
     
+    /// Joins a refresh that is already in flight rather than starting another
     @objc func refreshToken(_ resolve: RCTPromiseResolveBlock?,
                            _ reject: RCTPromiseRejectBlock?) {
-        authQueue.async {
-            guard let user = self.auth.currentUser else {
-                reject?("\(AuthError.userNotFound.rawValue)",
-                       AuthError.userNotFound.localizedDescription,
-                       AuthError.userNotFound)
-                return
-            }
-            
-            user.getIDTokenResult(forcingRefresh: true) { (result, error) in
-                if let error = error {
-                    Logger.shared.error("Token refresh failed", error: error)
-                    reject?("\(AuthError.tokenExpired.rawValue)",
-                           AuthError.tokenExpired.localizedDescription,
-                           AuthError.tokenExpired)
-                    return
-                }
-                
-                guard let token = result?.token else { return }
-                
-                // Update token cache
-                self.tokenCache[user.uid] = (token, result?.expirationDate ?? Date())
-                
+        tokenRefresher.refresh { result in
+            switch result {
+            case .success(let token):
                 let tokenData: [String: Any] = [
-                    "token": token,
-                    "expiresIn": result?.expirationDate.timeIntervalSinceNow ?? 0
+                    "token": token.value,
+                    "expiresIn": token.expirationDate.timeIntervalSinceNow
                 ]
-                
-                Logger.shared.info("Token refreshed successfully for user: \(user.uid)")
                 resolve?(tokenData)
+            case .failure(let error as AuthError) where error == .userNotFound:
+                reject?("\(AuthError.userNotFound.rawValue)",
+                       AuthError.userNotFound.localizedDescription,
+                       AuthError.userNotFound)
+            case .failure:
+                reject?("\(AuthError.tokenExpired.rawValue)",
+                       AuthError.tokenExpired.localizedDescription,
+                       AuthError.tokenExpired)
             }
         }
     }
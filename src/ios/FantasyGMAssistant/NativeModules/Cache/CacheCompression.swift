@@ -0,0 +1,63 @@
+//
+// CacheCompression.swift
+// FantasyGMAssistant
+//
+// Optional per-entry payload compression for the memory and disk cache tiers
+// Version: 1.0.0
+//
+
+import Foundation // iOS 14.0+
+
+// MARK: - Compression Constants
+private let COMPRESSION_MIN_BYTES = 4 * 1024 // 4KB; smaller payloads rarely shrink enough to pay off
+
+// MARK: - Compression Mode
+public enum CacheCompression {
+    /// Store the payload as-is
+    case none
+    /// Fast to decode; suited to entries read often, such as live trade analysis
+    case lz4
+    /// Better ratio at higher CPU cost; suited to cold entries such as season stat tables
+    case lzfse
+}
+
+// MARK: - Codec
+enum CacheCodec {
+    /// Compresses payloads at or above the size threshold, returning the stored bytes and the flag
+    /// describing them. Falls back to the raw payload if compression fails or does not shrink it.
+    static func encode(_ payload: Data, using compression: CacheCompression) -> (data: Data, flags: CacheRecordFlags) {
+        guard payload.count >= COMPRESSION_MIN_BYTES, let codec = parameters(for: compression) else {
+            return (payload, [])
+        }
+        
+        do {
+            let compressed = try (payload as NSData).compressed(using: codec.algorithm) as Data
+            guard compressed.count < payload.count else { return (payload, []) }
+            return (compressed, codec.flag)
+        } catch {
+            Logger.shared.error("Failed to compress cache payload", error: error)
+            return (payload, [])
+        }
+    }
+    
+    /// Restores the original payload from stored bytes according to the record flags
+    static func decode(_ data: Data, flags: CacheRecordFlags) throws -> Data {
+        if flags.contains(.lz4) {
+            return try (data as NSData).decompressed(using: .lz4) as Data
+        }
+        if flags.contains(.lzfse) {
+            return try (data as NSData).decompressed(using: .lzfse) as Data
+        }
+        return data
+    }
+    
+    // MARK: - Private Methods
+    private static func parameters(for compression: CacheCompression)
+        -> (algorithm: NSData.CompressionAlgorithm, flag: CacheRecordFlags)? {
+        switch compression {
+        case .none: return nil
+        case .lz4: return (.lz4, .lz4)
+        case .lzfse: return (.lzfse, .lzfse)
+        }
+    }
+}
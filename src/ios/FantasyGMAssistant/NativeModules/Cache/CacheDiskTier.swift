@@ -0,0 +1,129 @@
+//
+// CacheDiskTier.swift
+// FantasyGMAssistant
+//
+// Budgeted disk tier combining a record store with its LRU size index
+// Version: 1.0.0
+//
+
+import Foundation // iOS 14.0+
+
+// MARK: - Disk Tier Constants
+/// Share of the budget left to bytes of overwritten and removed records awaiting compaction.
+/// Live records are held to the rest, so compaction from the write path stays amortized.
+private let RECLAIMABLE_BUDGET_FRACTION = 0.25
+
+// MARK: - Disk Tier
+/// Owns the disk store and the LRU index that keeps it within its byte budget. Dead bytes a
+/// store has not yet reclaimed count against the budget too.
+/// Reads may run concurrently; writes, removals and maintenance must be serialized by the caller.
+final class CacheDiskTier {
+    private let store: DiskCacheStore
+    /// Recency and size of disk records, keyed like the memory tier; values are expiry dates
+    private let index: CacheLRU<Date>
+    private let version: String
+    private let costLimit: Int
+    
+    init(store: DiskCacheStore, costLimit: Int, version: String) {
+        self.store = store
+        self.index = CacheLRU<Date>(costLimit: costLimit - Int(Double(costLimit) * RECLAIMABLE_BUDGET_FRACTION))
+        self.version = version
+        self.costLimit = costLimit
+    }
+    
+    /// Bytes currently charged against the budget, live and awaiting compaction
+    var totalCost: Int {
+        return index.totalCost + store.reclaimableBytes
+    }
+    
+    /// Marks the key as recently used so hot keys served from memory do not age out of disk
+    func touch(_ key: String) {
+        index.touch(key)
+    }
+    
+    // MARK: - Reads
+    /// Returns the stored entry only if it is live, or merely current-version when `acceptExpired`
+    /// is set. Rejected records are filtered from the header alone without loading the payload.
+    func read(_ key: String, acceptExpired: Bool = false) throws -> CacheEntry? {
+        guard let header = store.header(for: key),
+              acceptExpired ? header.version == version : header.isLive(version: version) else {
+            return nil
+        }
+        
+        guard let record = try store.record(for: key) else { return nil }
+        index.touch(key)
+        return CacheEntry(data: record.payload,
+                          expiryDate: record.header.expiryDate,
+                          version: record.header.version,
+                          flags: record.header.flags)
+    }
+    
+    // MARK: - Writes
+    /// Writes the batch in one store call, then evicts least recently used records over budget.
+    /// Returns the number of records evicted.
+    func write(_ batch: [(key: String, entry: CacheEntry)]) throws -> Int {
+        let records = batch.map { item -> DiskCacheRecord in
+            let entry = item.entry
+            let header = CacheRecordHeader(payload: entry.data,
+                                           expiryDate: entry.expiryDate,
+                                           version: entry.version,
+                                           flags: entry.flags)
+            return (item.key, header, entry.data)
+        }
+        try store.write(records)
+        
+        var evicted: [(key: String, value: Date)] = []
+        for item in batch {
+            let cost = CacheRecordHeader.size + item.entry.data.count
+            evicted += index.insert(item.entry.expiryDate, forKey: item.key, cost: cost)
+        }
+        let evictedCount = evict(evicted)
+        compactIfOverBudget()
+        return evictedCount
+    }
+    
+    func remove(_ key: String) {
+        store.remove(key)
+        index.removeValue(forKey: key)
+    }
+    
+    func removeAll() {
+        store.removeAll()
+        index.removeAll()
+    }
+    
+    // MARK: - Maintenance
+    /// Loads live records from the store into the index, oldest first.
+    /// Returns the number of records evicted because the store was over budget.
+    func seed() -> Int {
+        var evicted: [(key: String, value: Date)] = []
+        for (key, header) in store.storedEntries() where header.isLive(version: version) {
+            evicted += index.insert(header.expiryDate, forKey: key, cost: CacheRecordHeader.size + header.payloadLength)
+        }
+        let evictedCount = evict(evicted)
+        compactIfOverBudget()
+        return evictedCount
+    }
+    
+    /// Drops expired records and compacts the store. Returns the number of records removed.
+    func removeExpired(now: Date = Date()) -> Int {
+        let removed = store.removeExpired(version: version, now: now)
+        index.removeAll { $0 <= now }
+        store.compactIfNeeded()
+        return removed
+    }
+    
+    // MARK: - Private Methods
+    private func compactIfOverBudget() {
+        guard totalCost > costLimit else { return }
+        store.compact()
+    }
+    
+    private func evict(_ evicted: [(key: String, value: Date)]) -> Int {
+        guard !evicted.isEmpty else { return 0 }
+        
+        evicted.forEach { store.remove($0.key) }
+        Logger.shared.debug("Evicted \(evicted.count) disk cache records over budget")
+        return evicted.count
+    }
+}
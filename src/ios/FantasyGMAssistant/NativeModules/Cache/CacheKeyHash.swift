@@ -0,0 +1,114 @@
+//
+// CacheKeyHash.swift
+// FantasyGMAssistant
+//
+// Fast non-cryptographic key hashing for disk cache file names
+// Version: 1.0.0
+//
+
+import Foundation // iOS 14.0+
+
+// MARK: - Hash Constants
+private let PRIME64_1: UInt64 = 0x9E37_79B1_85EB_CA87
+private let PRIME64_2: UInt64 = 0xC2B2_AE3D_27D4_EB4F
+private let PRIME64_3: UInt64 = 0x1656_67B1_9E37_79F9
+private let PRIME64_4: UInt64 = 0x85EB_CA77_C2B2_AE63
+private let PRIME64_5: UInt64 = 0x27D4_EB2F_1656_67C5
+private let HEX_DIGITS: [UInt8] = Array("0123456789abcdef".utf8)
+
+// MARK: - Key Hash
+/// XXH64 over the UTF-8 bytes of a cache key. File names are only used to locate records,
+/// so a 64-bit non-cryptographic hash is sufficient and avoids CommonCrypto on the hot path.
+enum CacheKeyHash {
+    static func hash(_ key: String, seed: UInt64 = 0) -> UInt64 {
+        var key = key
+        return key.withUTF8 { hash(UnsafeRawBufferPointer($0), seed: seed) }
+    }
+    
+    /// 16 lowercase hex digits written straight into the string's storage
+    static func fileName(for key: String) -> String {
+        let value = hash(key)
+        return String(unsafeUninitializedCapacity: 16) { buffer in
+            for index in 0..<16 {
+                let nibble = Int((value >> UInt64(60 - index * 4)) & 0xF)
+                buffer[index] = HEX_DIGITS[nibble]
+            }
+            return 16
+        }
+    }
+    
+    static func hash(_ bytes: UnsafeRawBufferPointer, seed: UInt64 = 0) -> UInt64 {
+        let length = bytes.count
+        var offset = 0
+        var result: UInt64
+        
+        if length >= 32 {
+            var v1 = seed &+ PRIME64_1 &+ PRIME64_2
+            var v2 = seed &+ PRIME64_2
+            var v3 = seed
+            var v4 = seed &- PRIME64_1
+            
+            while offset + 32 <= length {
+                v1 = round(v1, read64(bytes, offset))
+                v2 = round(v2, read64(bytes, offset + 8))
+                v3 = round(v3, read64(bytes, offset + 16))
+                v4 = round(v4, read64(bytes, offset + 24))
+                offset += 32
+            }
+            
+            result = rotl(v1, 1) &+ rotl(v2, 7) &+ rotl(v3, 12) &+ rotl(v4, 18)
+            result = merge(result, v1)
+            result = merge(result, v2)
+            result = merge(result, v3)
+            result = merge(result, v4)
+        } else {
+            result = seed &+ PRIME64_5
+        }
+        
+        result = result &+ UInt64(length)
+        
+        while offset + 8 <= length {
+            result ^= round(0, read64(bytes, offset))
+            result = rotl(result, 27) &* PRIME64_1 &+ PRIME64_4
+            offset += 8
+        }
+        
+        if offset + 4 <= length {
+            let lane = UInt64(UInt32(littleEndian: bytes.loadUnaligned(fromByteOffset: offset, as: UInt32.self)))
+            result ^= lane &* PRIME64_1
+            result = rotl(result, 23) &* PRIME64_2 &+ PRIME64_3
+            offset += 4
+        }
+        
+        while offset < length {
+            result ^= UInt64(bytes[offset]) &* PRIME64_5
+            result = rotl(result, 11) &* PRIME64_1
+            offset += 1
+        }
+        
+        // Final avalanche
+        result ^= result >> 33
+        result = result &* PRIME64_2
+        result ^= result >> 29
+        result = result &* PRIME64_3
+        result ^= result >> 32
+        return result
+    }
+    
+    // MARK: - Private Methods
+    private static func read64(_ bytes: UnsafeRawBufferPointer, _ offset: Int) -> UInt64 {
+        return UInt64(littleEndian: bytes.loadUnaligned(fromByteOffset: offset, as: UInt64.self))
+    }
+    
+    private static func rotl(_ value: UInt64, _ count: UInt64) -> UInt64 {
+        return (value << count) | (value >> (64 - count))
+    }
+    
+    private static func round(_ accumulator: UInt64, _ lane: UInt64) -> UInt64 {
+        return rotl(accumulator &+ lane &* PRIME64_2, 31) &* PRIME64_1
+    }
+    
+    private static func merge(_ accumulator: UInt64, _ value: UInt64) -> UInt64 {
+        return (accumulator ^ round(0, value)) &* PRIME64_1 &+ PRIME64_4
+    }
+}
@@ -0,0 +1,209 @@
+//
+// CacheLRU.swift
+// FantasyGMAssistant
+//
+// Thread-safe, size-accounted LRU used to budget the memory and disk cache tiers
+// Version: 1.0.0
+//
+
+import Foundation // iOS 14.0+
+
+// MARK: - LRU
+/// Keys are ordered by recency in a doubly-linked list; a dictionary gives O(1) lookup.
+/// Every operation takes an internal lock, so lookups from concurrent readers are safe.
+final class CacheLRU<Value> {
+    private final class Node {
+        let key: String
+        var value: Value
+        var cost: Int
+        weak var previous: Node?
+        var next: Node?
+        
+        init(key: String, value: Value, cost: Int) {
+            self.key = key
+            self.value = value
+            self.cost = cost
+        }
+    }
+    
+    private let lock = NSLock()
+    private var limit: Int
+    private var nodes: [String: Node] = [:]
+    private var head: Node?
+    private var tail: Node?
+    private var currentCost = 0
+    
+    init(costLimit: Int) {
+        self.limit = costLimit
+    }
+    
+    var costLimit: Int {
+        lock.lock()
+        defer { lock.unlock() }
+        return limit
+    }
+    
+    var totalCost: Int {
+        lock.lock()
+        defer { lock.unlock() }
+        return currentCost
+    }
+    
+    var count: Int {
+        lock.lock()
+        defer { lock.unlock() }
+        return nodes.count
+    }
+    
+    // MARK: - Access
+    /// Returns the value and marks the key as most recently used
+    func value(forKey key: String) -> Value? {
+        lock.lock()
+        defer { lock.unlock() }
+        
+        guard let node = nodes[key] else { return nil }
+        moveToFront(node)
+        return node.value
+    }
+    
+    /// Marks the key as most recently used without reading it
+    func touch(_ key: String) {
+        lock.lock()
+        defer { lock.unlock() }
+        
+        if let node = nodes[key] {
+            moveToFront(node)
+        }
+    }
+    
+    // MARK: - Mutation
+    /// Inserts or replaces a value, then evicts least recently used entries until the total
+    /// cost fits the limit. An entry larger than the limit is evicted along with everything else.
+    @discardableResult
+    func insert(_ value: Value, forKey key: String, cost: Int) -> [(key: String, value: Value)] {
+        lock.lock()
+        defer { lock.unlock() }
+        
+        if let node = nodes[key] {
+            currentCost += cost - node.cost
+            node.value = value
+            node.cost = cost
+            moveToFront(node)
+        } else {
+            let node = Node(key: key, value: value, cost: cost)
+            nodes[key] = node
+            currentCost += cost
+            pushFront(node)
+        }
+        
+        var evicted: [(key: String, value: Value)] = []
+        while currentCost > limit, let last = tail {
+            unlink(last)
+            evicted.append((last.key, last.value))
+        }
+        return evicted
+    }
+    
+    @discardableResult
+    func removeValue(forKey key: String) -> Value? {
+        lock.lock()
+        defer { lock.unlock() }
+        
+        guard let node = nodes[key] else { return nil }
+        unlink(node)
+        return node.value
+    }
+    
+    /// Removes every entry matching the predicate, returning how many were removed
+    @discardableResult
+    func removeAll(where shouldRemove: (Value) -> Bool) -> Int {
+        lock.lock()
+        defer { lock.unlock() }
+        
+        let matches = nodes.values.filter { shouldRemove($0.value) }
+        matches.forEach(unlink)
+        return matches.count
+    }
+    
+    /// Evicts least recently used entries until the total cost is at most `targetCost`,
+    /// returning how many were evicted
+    @discardableResult
+    func trim(toCost targetCost: Int) -> Int {
+        lock.lock()
+        defer { lock.unlock() }
+        
+        var evicted = 0
+        while currentCost > targetCost, let last = tail {
+            unlink(last)
+            evicted += 1
+        }
+        return evicted
+    }
+    
+    /// Changes the budget, evicting least recently used entries when it shrinks below the total
+    /// cost. Returns how many were evicted.
+    @discardableResult
+    func setCostLimit(_ costLimit: Int) -> Int {
+        lock.lock()
+        defer { lock.unlock() }
+        
+        limit = costLimit
+        var evicted = 0
+        while currentCost > limit, let last = tail {
+            unlink(last)
+            evicted += 1
+        }
+        return evicted
+    }
+    
+    func removeAll() {
+        lock.lock()
+        defer { lock.unlock() }
+        
+        nodes.removeAll()
+        head = nil
+        tail = nil
+        currentCost = 0
+    }
+    
+    // MARK: - Private Methods
+    // All helpers below must be called with `lock` held.
+    private func pushFront(_ node: Node) {
+        node.previous = nil
+        node.next = head
+        head?.previous = node
+        head = node
+        if tail == nil {
+            tail = node
+        }
+    }
+    
+    private func detach(_ node: Node) {
+        if let previous = node.previous {
+            previous.next = node.next
+        } else {
+            head = node.next
+        }
+        
+        if let next = node.next {
+            next.previous = node.previous
+        } else {
+            tail = node.previous
+        }
+        
+        node.previous = nil
+        node.next = nil
+    }
+    
+    private func moveToFront(_ node: Node) {
+        guard head !== node else { return }
+        detach(node)
+        pushFront(node)
+    }
+    
+    private func unlink(_ node: Node) {
+        detach(node)
+        nodes.removeValue(forKey: node.key)
+        currentCost -= node.cost
+    }
+}
@@ -0,0 +1,141 @@
+//
+// CacheManager+Loading.swift
+// FantasyGMAssistant
+//
+// Read-through loading with single-flight coalescing and stale-while-revalidate
+// Version: 1.0.0
+//
+
+import Foundation // iOS 14.0+
+
+// MARK: - Loading Errors
+public enum CacheLoadError: Error {
+    case decodingFailed
+}
+
+// MARK: - Load Group
+/// Tracks in-flight loads per key so concurrent misses share a single loader call
+final class CacheLoadGroup {
+    typealias Waiter = (Result<Data, Error>) -> Void
+    
+    private let lock = NSLock()
+    private var waiters: [String: [Waiter]] = [:]
+    
+    /// Registers interest in a load. Returns true when the caller must start the load;
+    /// otherwise the waiter is attached to the load already running for `key`.
+    /// A nil waiter starts a background refresh without waiting for its result.
+    func join(_ key: String, waiter: Waiter?) -> Bool {
+        lock.lock()
+        defer { lock.unlock() }
+        
+        if waiters[key] != nil {
+            if let waiter = waiter {
+                waiters[key]?.append(waiter)
+            }
+            return false
+        }
+        
+        waiters[key] = waiter.map { [$0] } ?? []
+        return true
+    }
+    
+    /// Ends the load for `key` and delivers the result to every waiter
+    func finish(_ key: String, with result: Result<Data, Error>) {
+        lock.lock()
+        let pending = waiters.removeValue(forKey: key) ?? []
+        lock.unlock()
+        
+        pending.forEach { $0(result) }
+    }
+}
+
+// MARK: - Read-Through Loading
+extension CacheManager {
+    /// Returns the cached data for `key`, or runs `loader` once for all concurrent callers that miss.
+    /// - Parameters:
+    ///   - key: Cache key of the data
+    ///   - ttl: Time-to-live applied to freshly loaded data
+    ///   - staleWhileRevalidate: Seconds past expiry during which the stale entry is served
+    ///     immediately while a single background refresh runs; 0 disables stale serving
+    ///   - loader: Fetches fresh data and calls its completion exactly once
+    ///   - completion: Invoked with the cached or loaded data, or the loader's error
+    public func getOrLoadData(forKey key: String,
+                              ttl: TimeInterval,
+                              staleWhileRevalidate: TimeInterval = 0,
+                              loader: @escaping (@escaping (Result<Data, Error>) -> Void) -> Void,
+                              completion: @escaping (Result<Data, Error>) -> Void) {
+        cacheQueue.async { [weak self] in
+            guard let self = self else { return }
+            
+            let now = Date()
+            if let entry = self.lookupEntry(key, acceptExpired: staleWhileRevalidate > 0),
+               let payload = try? entry.payload() {
+                if entry.expiryDate > now {
+                    completion(.success(payload))
+                    return
+                }
+                
+                if entry.expiryDate.addingTimeInterval(staleWhileRevalidate) > now {
+                    Logger.shared.debug("Serving stale cache entry while revalidating key: \(key)")
+                    completion(.success(payload))
+                    self.load(key, ttl: ttl, loader: loader, waiter: nil)
+                    return
+                }
+            }
+            
+            self.load(key, ttl: ttl, loader: loader, waiter: completion)
+        }
+    }
+    
+    /// Typed async variant of `getOrLoadData(forKey:ttl:staleWhileRevalidate:loader:completion:)`
+    public func getOrLoad<T: Cacheable>(_ key: String,
+                                        type: T.Type,
+                                        ttl: TimeInterval,
+                                        staleWhileRevalidate: TimeInterval = 0,
+                                        loader: @escaping () async throws -> T) async throws -> T {
+        let data: Data = try await withCheckedThrowingContinuation { continuation in
+            getOrLoadData(forKey: key, ttl: ttl, staleWhileRevalidate: staleWhileRevalidate, loader: { done in
+                Task {
+                    do {
+                        done(.success(try await loader().toCacheData()))
+                    } catch {
+                        done(.failure(error))
+                    }
+                }
+            }, completion: { continuation.resume(with: $0) })
+        }
+        
+        guard let object = try T.fromCacheData(data) else { throw CacheLoadError.decodingFailed }
+        return object
+    }
+    
+    // MARK: - Private Methods
+    private func load(_ key: String,
+                      ttl: TimeInterval,
+                      loader: (@escaping (Result<Data, Error>) -> Void) -> Void,
+                      waiter: CacheLoadGroup.Waiter?) {
+        guard inFlightLoads.join(key, waiter: waiter) else {
+            Logger.shared.debug("Coalesced cache load for key: \(key)")
+            return
+        }
+        
+        loader { [weak self] result in
+            guard let self = self else { return }
+            
+            guard case .success(let data) = result else {
+                self.inFlightLoads.finish(key, with: result)
+                return
+            }
+            
+            // One write for all waiters. The load stays registered until the barrier queued behind
+            // the store's memory insert has run, so no caller can miss in between and load again.
+            // Waiters are then released off the cache queue so they never run inside the barrier.
+            self.store([key: data], ttl: ttl, completion: nil)
+            self.cacheQueue.async(flags: .barrier) {
+                DispatchQueue.global(qos: .utility).async {
+                    self.inFlightLoads.finish(key, with: result)
+                }
+            }
+        }
+    }
+}
@@ -16,24 +16,8 @@
 // Export module to React Native
 RCT_EXPORT_MODULE()
 
-- (instancetype)init {
-    self = [super init];
-    if (self) {
-        // Initialize dedicated serial queue for thread-safe cache operations
-        _cacheQueue = dispatch_queue_create("com.fantasygm.cache", DISPATCH_QUEUE_SERIAL);
-        
-        // Register for memory warning notifications
-        [[NSNotificationCenter defaultCenter] addObserver:self
-                                               selector:@selector(handleMemoryWarning:)
-                                                   name:UIApplicationDidReceiveMemoryWarningNotification
-                                                 object:nil];
-    }
-    return self;
-}
-
-- (void)dealloc {
-    [[NSNotificationCenter defaultCenter] removeObserver:self];
-}
+// Memory warnings are handled by the Swift CacheManager through MemoryPressureCoordinator,
+// which trims the memory tier instead of clearing the persisted cache.
 
 // Thread-safe implementation for storing data in cache
 RCT_EXPORT_METHOD(setData:(NSString *)key
@@ -50,36 +34,29 @@ RCT_EXPORT_METHOD(setData:(NSString *)key
         return;
     }
     
-    dispatch_async(self->_cacheQueue, ^{
-        @try {
-            // Convert parameters for Swift interop
-            NSTimeInterval timeInterval = [ttl doubleValue];
-            
-            // Store data using Swift CacheManager
-            [[CacheManager shared] setData:data
-                                 withKey:key
-                                    ttl:timeInterval
-                              callback:^(NSError * _Nullable error) {
-                if (error) {
-                    reject(@"storage_failed",
-                          @"Failed to store data in cache",
-                          error);
-                } else {
-                    resolve(@YES);
-                }
-            }];
-            
-            dispatch_barrier_async(self->_cacheQueue, ^{
-                // Memory barrier to ensure thread safety
-            });
-            
-        } @catch (NSException *exception) {
-            NSError *error = [NSError errorWithDomain:kCacheManagerErrorDomain
-                                               code:CacheManagerErrorStorageFailed
-                                           userInfo:@{NSLocalizedDescriptionKey: exception.reason}];
-            reject(@"storage_failed", @"Failed to store data in cache", error);
-        }
-    });
+    @try {
+        // Convert parameters for Swift interop
+        NSTimeInterval timeInterval = [ttl doubleValue];
+        
+        // Store data using Swift CacheManager
+        [[CacheManager shared] setData:data
+                             withKey:key
+                                ttl:timeInterval
+                          callback:^(NSError * _Nullable error) {
+            if (error) {
+                reject(@"storage_failed",
+                      @"Failed to store data in cache",
+                      error);
+            } else {
+                resolve(@YES);
+            }
+        }];
+    } @catch (NSException *exception) {
+        NSError *error = [NSError errorWithDomain:kCacheManagerErrorDomain
+                                           code:CacheManagerErrorStorageFailed
+                                       userInfo:@{NSLocalizedDescriptionKey: exception.reason}];
+        reject(@"storage_failed", @"Failed to store data in cache", error);
+    }
 }
 
 // Thread-safe implementation for retrieving data from cache
@@ -95,31 +72,88 @@ RCT_EXPORT_METHOD(getData:(NSString *)key
         return;
     }
     
-    dispatch_async(self->_cacheQueue, ^{
-        @try {
-            // Retrieve data using Swift CacheManager
-            [[CacheManager shared] getDataForKey:key
-                                     callback:^(NSData * _Nullable data, NSError * _Nullable error) {
-                if (error) {
-                    reject(@"retrieval_failed",
-                          @"Failed to retrieve data from cache",
-                          error);
-                } else {
-                    resolve(data ?: [NSNull null]);
-                }
-            }];
-            
-            dispatch_barrier_async(self->_cacheQueue, ^{
-                // Memory barrier to ensure thread safety
-            });
-            
-        } @catch (NSException *exception) {
-            NSError *error = [NSError errorWithDomain:kCacheManagerErrorDomain
-                                               code:CacheManagerErrorRetrievalFailed
-                                           userInfo:@{NSLocalizedDescriptionKey: exception.reason}];
-            reject(@"retrieval_failed", @"Failed to retrieve data from cache", error);
+    // Completion-based lookup; no queue hop or blocking wait on the bridge side
+    [[CacheManager shared] getDataForKey:key
+                                callback:^(NSData * _Nullable data, NSError * _Nullable error) {
+        if (error) {
+            reject(@"retrieval_failed",
+                  @"Failed to retrieve data from cache",
+                  error);
+        } else {
+            resolve(data ?: [NSNull null]);
         }
-    });
+    }];
+}
+
+// Stores a batch of entries with one queue hop and one grouped disk write
+RCT_EXPORT_METHOD(setMany:(NSDictionary<NSString *, NSData *> *)entries
+                  ttl:(NSNumber *)ttl
+                  resolve:(RCTPromiseResolveBlock)resolve
+                  reject:(RCTPromiseRejectBlock)reject) {
+    
+    __block BOOL validEntries = (entries != nil);
+    [entries enumerateKeysAndObjectsUsingBlock:^(id key, id value, BOOL *stop) {
+        if (![key isKindOfClass:[NSString class]] || ![value isKindOfClass:[NSData class]]) {
+            validEntries = NO;
+            *stop = YES;
+        }
+    }];
+    
+    if (!validEntries || !ttl) {
+        NSError *error = [NSError errorWithDomain:kCacheManagerErrorDomain
+                                           code:CacheManagerErrorInvalidInput
+                                       userInfo:@{NSLocalizedDescriptionKey: @"Invalid input parameters"}];
+        reject(@"invalid_input", @"Entries must map string keys to data, and TTL is required", error);
+        return;
+    }
+    
+    @try {
+        [[CacheManager shared] setManyData:entries
+                                       ttl:[ttl doubleValue]
+                                  callback:^(NSError * _Nullable error) {
+            if (error) {
+                reject(@"storage_failed",
+                      @"Failed to store data in cache",
+                      error);
+            } else {
+                resolve(@YES);
+            }
+        }];
+    } @catch (NSException *exception) {
+        NSError *error = [NSError errorWithDomain:kCacheManagerErrorDomain
+                                           code:CacheManagerErrorStorageFailed
+                                       userInfo:@{NSLocalizedDescriptionKey: exception.reason}];
+        reject(@"storage_failed", @"Failed to store data in cache", error);
+    }
+}
+
+// Retrieves a batch of entries with one queue hop; resolves with a dictionary of hits
+RCT_EXPORT_METHOD(getMany:(NSArray<NSString *> *)keys
+                  resolve:(RCTPromiseResolveBlock)resolve
+                  reject:(RCTPromiseRejectBlock)reject) {
+    
+    NSPredicate *nonString = [NSPredicate predicateWithBlock:^BOOL(id key, NSDictionary *bindings) {
+        return ![key isKindOfClass:[NSString class]];
+    }];
+    
+    if (!keys || [keys filteredArrayUsingPredicate:nonString].count > 0) {
+        NSError *error = [NSError errorWithDomain:kCacheManagerErrorDomain
+                                           code:CacheManagerErrorInvalidInput
+                                       userInfo:@{NSLocalizedDescriptionKey: @"Keys are required"}];
+        reject(@"invalid_input", @"Keys are required", error);
+        return;
+    }
+    
+    [[CacheManager shared] getManyDataForKeys:keys
+                                     callback:^(NSDictionary<NSString *, NSData *> *results, NSError * _Nullable error) {
+        if (error) {
+            reject(@"retrieval_failed",
+                  @"Failed to retrieve data from cache",
+                  error);
+        } else {
+            resolve(results);
+        }
+    }];
 }
 
 // Thread-safe implementation for removing data from cache
@@ -135,72 +169,47 @@ RCT_EXPORT_METHOD(removeData:(NSString *)key
         return;
     }
     
-    dispatch_async(self->_cacheQueue, ^{
-        @try {
-            // Remove data using Swift CacheManager
-            [[CacheManager shared] removeDataForKey:key
-                                        callback:^(NSError * _Nullable error) {
-                if (error) {
-                    reject(@"removal_failed",
-                          @"Failed to remove data from cache",
-                          error);
-                } else {
-                    resolve(@YES);
-                }
-            }];
-            
-            dispatch_barrier_async(self->_cacheQueue, ^{
-                // Memory barrier to ensure thread safety
-            });
-            
-        } @catch (NSException *exception) {
-            NSError *error = [NSError errorWithDomain:kCacheManagerErrorDomain
-                                               code:CacheManagerErrorClearFailed
-                                           userInfo:@{NSLocalizedDescriptionKey: exception.reason}];
-            reject(@"removal_failed", @"Failed to remove data from cache", error);
-        }
-    });
+    @try {
+        // Remove data using Swift CacheManager
+        [[CacheManager shared] removeDataForKey:key
+                                    callback:^(NSError * _Nullable error) {
+            if (error) {
+                reject(@"removal_failed",
+                      @"Failed to remove data from cache",
+                      error);
+            } else {
+                resolve(@YES);
+            }
+        }];
+    } @catch (NSException *exception) {
+        NSError *error = [NSError errorWithDomain:kCacheManagerErrorDomain
+                                           code:CacheManagerErrorClearFailed
+                                       userInfo:@{NSLocalizedDescriptionKey: exception.reason}];
+        reject(@"removal_failed", @"Failed to remove data from cache", error);
+    }
 }
 
 // Thread-safe implementation for clearing all cached data
 RCT_EXPORT_METHOD(clearCache:(RCTPromiseResolveBlock)resolve
                   reject:(RCTPromiseRejectBlock)reject) {
     
-    dispatch_async(self->_cacheQueue, ^{
-        @try {
-            // Clear cache using Swift CacheManager
-            [[CacheManager shared] clearCacheWithCallback:^(NSError * _Nullable error) {
-                if (error) {
-                    reject(@"clear_failed",
-                          @"Failed to clear cache",
-                          error);
-                } else {
-                    resolve(@YES);
-                }
-            }];
-            
-            dispatch_barrier_async(self->_cacheQueue, ^{
-                // Memory barrier to ensure thread safety
-            });
-            
-            // Post notification for low memory cleanup
-            [[NSNotificationCenter defaultCenter] postNotificationName:UIApplicationDidReceiveMemoryWarningNotification
-                                                            object:nil];
-            
-        } @catch (NSException *exception) {
-            NSError *error = [NSError errorWithDomain:kCacheManagerErrorDomain
-                                               code:CacheManagerErrorClearFailed
-                                           userInfo:@{NSLocalizedDescriptionKey: exception.reason}];
-            reject(@"clear_failed", @"Failed to clear cache", error);
-        }
-    });
-}
-
-// Handle memory warning notifications
-- (void)handleMemoryWarning:(NSNotification *)notification {
-    dispatch_async(self->_cacheQueue, ^{
-        [[CacheManager shared] clearCacheWithCallback:nil];
-    });
+    @try {
+        // Clear cache using Swift CacheManager
+        [[CacheManager shared] clearCacheWithCallback:^(NSError * _Nullable error) {
+            if (error) {
+                reject(@"clear_failed",
+                      @"Failed to clear cache",
+                      error);
+            } else {
+                resolve(@YES);
+            }
+        }];
+    } @catch (NSException *exception) {
+        NSError *error = [NSError errorWithDomain:kCacheManagerErrorDomain
+                                           code:CacheManagerErrorClearFailed
+                                       userInfo:@{NSLocalizedDescriptionKey: exception.reason}];
+        reject(@"clear_failed", @"Failed to clear cache", error);
+    }
 }
 
 @end
\ No newline at end of file
@@ -13,73 +13,54 @@ private let CACHE_VERSION = "1.0"
 private let MAX_CACHE_SIZE_MB = 100
 private let DISK_CACHE_PATH = "/Library/Caches/FantasyGM/"
 private let MAX_MEMORY_COST = 1024 * 1024 * 50 // 50MB
-
-// MARK: - Cacheable Protocol
-public protocol Cacheable {
-    var cacheKey: String { get }
-    var expiryDate: Date { get }
-    var dataVersion: String { get }
-    
-    func toCacheData() throws -> Data
-    static func fromCacheData(_ data: Data) throws -> Self?
-}
-
-// MARK: - Cache Entry
-private class CacheEntry: NSObject {
-    let data: Data
-    let expiryDate: Date
-    let version: String
-    let createdAt: Date
-    
-    init(data: Data, expiryDate: Date, version: String) {
-        self.data = data
-        self.expiryDate = expiryDate
-        self.version = version
-        self.createdAt = Date()
-        super.init()
-    }
-}
-
-// MARK: - Cache Metrics
-private struct CacheMetrics {
-    var hits: Int = 0
-    var misses: Int = 0
-    var diskWrites: Int = 0
-    var evictions: Int = 0
-    var size: Int = 0
-}
+private let DISK_CACHE_BACKEND: DiskCacheBackend = .packFile
 
 // MARK: - Cache Manager
 @objc public class CacheManager: NSObject {
     // MARK: - Properties
     public static let shared = CacheManager()
     
-    private let memoryCache: NSCache<NSString, CacheEntry>
+    private let memoryCache: CacheLRU<CacheEntry>
     private let fileManager: FileManager
-    private let cacheQueue: DispatchQueue
+    private let diskTier: CacheDiskTier
+    /// Internal so `CacheManager+Loading` can hop onto it; see `lookupEntry(_:acceptExpired:)`
+    let cacheQueue: DispatchQueue
+    private let diskQueue: DispatchQueue
+    private let metricsLock: NSLock
     private var cacheMetrics: CacheMetrics
+    let inFlightLoads = CacheLoadGroup()
+    private let pendingWrites = CachePendingWrites()
     
     // MARK: - Initialization
     private override init() {
         // Initialize properties
-        memoryCache = NSCache<NSString, CacheEntry>()
-        memoryCache.totalCostLimit = MAX_MEMORY_COST
+        memoryCache = CacheLRU<CacheEntry>(costLimit: MAX_MEMORY_COST)
         fileManager = FileManager.default
-        cacheQueue = DispatchQueue(label: "com.fantasygm.cache", qos: .utility)
+        // Lookups run concurrently; mutations are submitted as barriers
+        cacheQueue = DispatchQueue(label: "com.fantasygm.cache", qos: .utility, attributes: .concurrent)
+        // Disk writes are serialized separately so readers never wait on file I/O
+        diskQueue = DispatchQueue(label: "com.fantasygm.cache.disk", qos: .utility)
+        metricsLock = NSLock()
         cacheMetrics = CacheMetrics()
+        let cachePath = NSSearchPathForDirectoriesInDomains(.cachesDirectory, .userDomainMask, true).first!
+        let diskCachePath = (cachePath as NSString).appendingPathComponent(DISK_CACHE_PATH)
+        let diskStore = DISK_CACHE_BACKEND.makeStore(directory: diskCachePath, fileManager: fileManager)
+        diskTier = CacheDiskTier(store: diskStore, costLimit: MAX_CACHE_SIZE_MB * 1024 * 1024, version: CACHE_VERSION)
         
         super.init()
         
-        // Setup cache directory
-        setupCacheDirectory()
+        // Account for records persisted by earlier launches
+        diskQueue.async { [weak self] in
+            guard let self = self else { return }
+            let evicted = self.diskTier.seed()
+            self.recordMetrics { $0.evictions += evicted }
+        }
+        
+        // Trim the memory tier coldest-first under memory pressure; the disk tier is unaffected
+        MemoryPressureCoordinator.shared.register(self, name: "CacheManager", priority: .normal)
         
-        // Configure memory warning handling
-        NotificationCenter.default.addObserver(
-            self,
-            selector: #selector(handleMemoryWarning),
-            name: UIApplication.didReceiveMemoryWarningNotification,
-            object: nil
-        )
+        // Shrink the memory budget on slower or constrained devices
+        PerformanceProfileMonitor.shared.register(self)
         
         // Start cleanup timer
         startCleanupTimer()
@@ -88,147 +69,329 @@ private struct CacheMetrics {
     }
     
     // MARK: - Public Methods
-    public func set<T: Cacheable>(_ object: T, ttl: TimeInterval) {
+    /// Stores an object in both tiers. `compression` applies to large payloads only, and
+    /// entries are charged against both budgets at their stored size.
+    public func set<T: Cacheable>(_ object: T, ttl: TimeInterval, compression: CacheCompression = .none) {
+        do {
+            store([object.cacheKey: try object.toCacheData()], ttl: ttl, compression: compression, completion: nil)
+        } catch {
+            Logger.shared.error("Failed to cache object", error: error)
+        }
+    }
+    
+    /// Stores several objects with one barrier and one batched disk write
+    public func setMany<T: Cacheable>(_ objects: [T], ttl: TimeInterval, compression: CacheCompression = .none) {
+        do {
+            var entries: [String: Data] = [:]
+            for object in objects {
+                entries[object.cacheKey] = try object.toCacheData()
+            }
+            store(entries, ttl: ttl, compression: compression, completion: nil)
+        } catch {
+            Logger.shared.error("Failed to cache objects", error: error)
+        }
+    }
+    
+    /// Looks up a cached object without blocking the caller.
+    /// - Parameters:
+    ///   - key: Cache key of the object
+    ///   - type: Concrete `Cacheable` type to decode
+    ///   - completion: Invoked on the cache queue with the decoded object, or nil on miss
+    public func get<T: Cacheable>(_ key: String, type: T.Type, completion: @escaping (T?) -> Void) {
         cacheQueue.async { [weak self] in
-            guard let self = self else { return }
+            guard let self = self, let entry = self.lookupEntry(key) else {
+                completion(nil)
+                return
+            }
             
             do {
-                let data = try object.toCacheData()
-                let expiryDate = Date().addingTimeInterval(ttl)
-                let entry = CacheEntry(data: data, expiryDate: expiryDate, version: CACHE_VERSION)
-                
-                // Store in memory
-                self.memoryCache.setObject(entry, forKey: object.cacheKey as NSString)
-                
-                // Store on disk
-                try self.writeToDisk(key: object.cacheKey, entry: entry)
-                
-                self.cacheMetrics.size += data.count
-                Logger.shared.debug("Cached object with key: \(object.cacheKey)")
+                completion(try T.fromCacheData(try entry.payload()))
             } catch {
-                Logger.shared.error("Failed to cache object", error: error)
+                Logger.shared.error("Failed to deserialize cached object", error: error)
+                completion(nil)
             }
         }
     }
     
+    /// Looks up several objects in one queue hop.
+    /// - Parameters:
+    ///   - keys: Cache keys of the objects
+    ///   - type: Concrete `Cacheable` type to decode
+    ///   - completion: Invoked on the cache queue with the decoded hits; misses are omitted
+    public func getMany<T: Cacheable>(_ keys: [String], type: T.Type, completion: @escaping ([String: T]) -> Void) {
+        cacheQueue.async { [weak self] in
+            let hits = self?.lookupMany(keys) ?? [:]
+            completion(hits.compactMapValues { data in
+                do {
+                    return try T.fromCacheData(data)
+                } catch {
+                    Logger.shared.error("Failed to deserialize cached object", error: error)
+                    return nil
+                }
+            })
+        }
+    }
+    
+    /// Async variant of `get(_:type:completion:)`
+    public func get<T: Cacheable>(_ key: String, type: T.Type) async -> T? {
+        return await withCheckedContinuation { continuation in
+            get(key, type: type) { continuation.resume(returning: $0) }
+        }
+    }
+    
+    /// Blocking lookup kept for synchronous callers such as tests; app code uses the completion or
+    /// async `get`. Must not be called from the main thread or the React Native method queue.
     public func get<T: Cacheable>(_ key: String, type: T.Type) -> T? {
         var result: T?
         let semaphore = DispatchSemaphore(value: 0)
         
+        get(key, type: type) { object in
+            result = object
+            semaphore.signal()
+        }
+        
+        if semaphore.wait(timeout: .now() + 2.0) == .timedOut {
+            Logger.shared.error("Timed out waiting for cache lookup for key: \(key)")
+        }
+        return result
+    }
+    
+    /// Raw data lookup used by the React Native bridge
+    /// - Parameters:
+    ///   - key: Cache key of the data
+    ///   - callback: Invoked on the cache queue with the cached bytes, or nil on miss
+    @objc(getDataForKey:callback:)
+    public func getData(forKey key: String, callback: @escaping (Data?, Error?) -> Void) {
         cacheQueue.async { [weak self] in
-            guard let self = self else {
-                semaphore.signal()
-                return
+            do {
+                callback(try self?.lookupEntry(key)?.payload(), nil)
+            } catch {
+                callback(nil, error)
             }
+        }
+    }
+    
+    public func remove(_ key: String) {
+        remove(key, completion: nil)
+    }
+    
+    public func clear() {
+        clear(completion: nil)
+    }
+    
+    /// Snapshot of hit, eviction and size counters
+    public var metrics: CacheMetrics {
+        metricsLock.lock()
+        var snapshot = cacheMetrics
+        metricsLock.unlock()
+        
+        snapshot.size = diskTier.totalCost
+        snapshot.memorySize = memoryCache.totalCost
+        return snapshot
+    }
+    
+    // MARK: - Bridge Methods
+    @objc(setData:withKey:ttl:callback:)
+    public func setData(_ data: Data, withKey key: String, ttl: TimeInterval, callback: ((Error?) -> Void)?) {
+        store([key: data], ttl: ttl, completion: callback)
+    }
+    
+    @objc(setManyData:ttl:callback:)
+    public func setManyData(_ entries: [String: Data], ttl: TimeInterval, callback: ((Error?) -> Void)?) {
+        store(entries, ttl: ttl, completion: callback)
+    }
+    
+    /// Raw batch lookup used by the React Native bridge; misses are omitted from the result
+    @objc(getManyDataForKeys:callback:)
+    public func getManyData(forKeys keys: [String], callback: @escaping ([String: Data], Error?) -> Void) {
+        cacheQueue.async { [weak self] in
+            callback(self?.lookupMany(keys) ?? [:], nil)
+        }
+    }
+    
+    @objc(removeDataForKey:callback:)
+    public func removeData(forKey key: String, callback: ((Error?) -> Void)?) {
+        remove(key, completion: callback)
+    }
+    
+    @objc(clearCacheWithCallback:)
+    public func clearCache(callback: ((Error?) -> Void)?) {
+        clear(completion: callback)
+    }
+    
+    // MARK: - Internal Methods
+    /// Inserts into memory under a barrier, then writes to disk. Internal for `CacheManager+Loading`.
+    /// Compression runs on the calling thread, alongside the caller's own encoding.
+    func store(_ entries: [String: Data], ttl: TimeInterval, compression: CacheCompression = .none,
+               completion: ((Error?) -> Void)?) {
+        let expiryDate = Date().addingTimeInterval(ttl)
+        let batch = entries.map { key, data -> (key: String, entry: CacheEntry) in
+            let stored = CacheCodec.encode(data, using: compression)
+            let entry = CacheEntry(data: stored.data, expiryDate: expiryDate, version: CACHE_VERSION, flags: stored.flags)
+            return (key, entry)
+        }
+        
+        cacheQueue.async(flags: .barrier) { [weak self] in
+            guard let self = self else { return }
             
-            // Try memory cache first
-            if let entry = self.memoryCache.object(forKey: key as NSString) {
-                if entry.expiryDate > Date() && entry.version == CACHE_VERSION {
-                    do {
-                        result = try T.fromCacheData(entry.data)
-                        self.cacheMetrics.hits += 1
-                        Logger.shared.debug("Memory cache hit for key: \(key)")
-                    } catch {
-                        Logger.shared.error("Failed to deserialize cached object", error: error)
-                    }
-                    semaphore.signal()
-                    return
-                }
-            }
+            // Store in memory
+            self.pendingWrites.add(batch)
+            batch.forEach { self.insertIntoMemory($0.entry, forKey: $0.key) }
             
-            // Try disk cache
-            do {
-                if let entry = try self.readFromDisk(key: key) {
-                    if entry.expiryDate > Date() && entry.version == CACHE_VERSION {
-                        result = try T.fromCacheData(entry.data)
-                        // Update memory cache
-                        self.memoryCache.setObject(entry, forKey: key as NSString)
-                        self.cacheMetrics.hits += 1
-                        Logger.shared.debug("Disk cache hit for key: \(key)")
+            // Store on disk
+            self.diskQueue.async {
+                defer { self.pendingWrites.finish(batch) }
+                do {
+                    let evicted = try PerformanceTracer.shared.trace("cache_disk_write") {
+                        try self.diskTier.write(batch)
+                    }
+                    self.recordMetrics {
+                        $0.diskWrites += batch.count
+                        $0.evictions += evicted
                     }
+                    Logger.shared.debug("Cached \(batch.count) object(s)")
+                    completion?(nil)
+                } catch {
+                    Logger.shared.error("Failed to cache object", error: error)
+                    completion?(error)
                 }
-            } catch {
-                Logger.shared.error("Failed to read from disk cache", error: error)
             }
-            
-            if result == nil {
-                self.cacheMetrics.misses += 1
-                Logger.shared.debug("Cache miss for key: \(key)")
+        }
+    }
+    
+    /// Memory-then-disk lookup. Runs concurrently on `cacheQueue`, so it must not mutate shared state
+    /// other than the thread-safe tiers and the locked metrics. Expired entries are only returned
+    /// when `acceptExpired` is set, for stale-while-revalidate loads.
+    func lookupEntry(_ key: String, acceptExpired: Bool = false) -> CacheEntry? {
+        // Try memory cache first
+        if let entry = memoryCache.value(forKey: key),
+           (acceptExpired || entry.expiryDate > Date()) && entry.version == CACHE_VERSION {
+            // Keep hot keys from aging out of the disk tier while memory serves them
+            diskTier.touch(key)
+            recordMetrics { $0.hits += 1 }
+            Logger.shared.debug("Memory cache hit for key: \(key)")
+            return entry
+        }
+        
+        // A write still in flight is newer than the disk record
+        if let entry = pendingWrites.entry(forKey: key) {
+            guard acceptExpired || entry.expiryDate > Date() else {
+                recordMetrics { $0.misses += 1 }
+                return nil
             }
-            
-            semaphore.signal()
+            insertIntoMemory(entry, forKey: key)
+            recordMetrics { $0.hits += 1 }
+            return entry
         }
         
-        _ = semaphore.wait(timeout: .now() + 2.0)
-        return result
+        // Try disk cache
+        do {
+            if let entry = try PerformanceTracer.shared.trace("cache_disk_read", {
+                try diskTier.read(key, acceptExpired: acceptExpired)
+            }) {
+                // Update memory cache
+                insertIntoMemory(entry, forKey: key)
+                recordMetrics { $0.hits += 1 }
+                Logger.shared.debug("Disk cache hit for key: \(key)")
+                return entry
+            }
+        } catch {
+            Logger.shared.error("Failed to read from disk cache", error: error)
+        }
+        
+        recordMetrics { $0.misses += 1 }
+        Logger.shared.debug("Cache miss for key: \(key)")
+        return nil
     }
     
-    public func remove(_ key: String) {
-        cacheQueue.async { [weak self] in
+    // MARK: - Private Methods
+    private func remove(_ key: String, completion: ((Error?) -> Void)?) {
+        cacheQueue.async(flags: .barrier) { [weak self] in
             guard let self = self else { return }
             
             // Remove from memory
-            self.memoryCache.removeObject(forKey: key as NSString)
+            self.memoryCache.removeValue(forKey: key)
             
-            // Remove from disk
-            let diskPath = self.diskPath(for: key)
-            try? self.fileManager.removeItem(atPath: diskPath)
+            // Remove from disk. Waits for pending writes so a queued write cannot resurrect the entry
+            // and no reader can observe the stale file once the barrier completes.
+            self.diskQueue.sync {
+                self.diskTier.remove(key)
+            }
             
             Logger.shared.debug("Removed cached object with key: \(key)")
+            completion?(nil)
         }
     }
     
-    public func clear() {
-        cacheQueue.async { [weak self] in
+    private func clear(completion: ((Error?) -> Void)?) {
+        cacheQueue.async(flags: .barrier) { [weak self] in
             guard let self = self else { return }
             
             // Clear memory cache
-            self.memoryCache.removeAllObjects()
+            self.memoryCache.removeAll()
+            self.recordMetrics { $0 = CacheMetrics() }
             
             // Clear disk cache
-            let cachePath = NSSearchPathForDirectoriesInDomains(.cachesDirectory, .userDomainMask, true).first!
-            let diskCachePath = (cachePath as NSString).appendingPathComponent(DISK_CACHE_PATH)
-            try? self.fileManager.removeItem(atPath: diskCachePath)
-            try? self.fileManager.createDirectory(atPath: diskCachePath, withIntermediateDirectories: true)
+            self.diskQueue.sync {
+                self.diskTier.removeAll()
+            }
             
-            self.cacheMetrics = CacheMetrics()
             Logger.shared.debug("Cache cleared")
+            completion?(nil)
         }
     }
     
-    // MARK: - Private Methods
-    private func setupCacheDirectory() {
-        let cachePath = NSSearchPathForDirectoriesInDomains(.cachesDirectory, .userDomainMask, true).first!
-        let diskCachePath = (cachePath as NSString).appendingPathComponent(DISK_CACHE_PATH)
-        
-        if !fileManager.fileExists(atPath: diskCachePath) {
-            try? fileManager.createDirectory(atPath: diskCachePath, withIntermediateDirectories: true)
-        }
-    }
-    
-    private func diskPath(for key: String) -> String {
-        let cachePath = NSSearchPathForDirectoriesInDomains(.cachesDirectory, .userDomainMask, true).first!
-        let diskCachePath = (cachePath as NSString).appendingPathComponent(DISK_CACHE_PATH)
-        return (diskCachePath as NSString).appendingPathComponent(key.md5)
-    }
-    
-    private func writeToDisk(key: String, entry: CacheEntry) throws {
-        let path = diskPath(for: key)
-        try entry.data.write(to: URL(fileURLWithPath: path))
-        self.cacheMetrics.diskWrites += 1
+    private func recordMetrics(_ update: (inout CacheMetrics) -> Void) {
+        metricsLock.lock()
+        defer { metricsLock.unlock() }
+        update(&cacheMetrics)
     }
     
-    private func readFromDisk(key: String) throws -> CacheEntry? {
-        let path = diskPath(for: key)
-        guard fileManager.fileExists(atPath: path) else { return nil }
+    /// Batch lookup for a single queue hop. Memory hits are collected first so the
+    /// remaining keys are read from disk in one pass.
+    private func lookupMany(_ keys: [String]) -> [String: Data] {
+        let uniqueKeys = Set(keys)
+        var results: [String: Data] = [:]
+        var diskKeys: [String] = []
+        let now = Date()
+        
+        for key in uniqueKeys {
+            if let entry = memoryCache.value(forKey: key), entry.expiryDate > now && entry.version == CACHE_VERSION,
+               let payload = try? entry.payload() {
+                diskTier.touch(key)
+                results[key] = payload
+            } else {
+                diskKeys.append(key)
+            }
+        }
+        
+        for key in diskKeys {
+            do {
+                if let entry = pendingWrites.entry(forKey: key) {
+                    if entry.expiryDate > now {
+                        insertIntoMemory(entry, forKey: key)
+                        results[key] = try entry.payload()
+                    }
+                } else if let entry = try diskTier.read(key) {
+                    insertIntoMemory(entry, forKey: key)
+                    results[key] = try entry.payload()
+                }
+            } catch {
+                Logger.shared.error("Failed to read from disk cache", error: error)
+            }
+        }
         
-        let data = try Data(contentsOf: URL(fileURLWithPath: path))
-        return CacheEntry(data: data, expiryDate: Date().addingTimeInterval(3600), version: CACHE_VERSION)
+        recordMetrics {
+            $0.hits += results.count
+            $0.misses += uniqueKeys.count - results.count
+        }
+        return results
     }
     
-    @objc private func handleMemoryWarning() {
-        memoryCache.removeAllObjects()
-        Logger.shared.debug("Cleared memory cache due to memory warning")
+    /// Charges the entry against the memory budget; evicted entries remain available on disk
+    private func insertIntoMemory(_ entry: CacheEntry, forKey key: String) {
+        let evicted = memoryCache.insert(entry, forKey: key, cost: entry.data.count)
+        recordMetrics { $0.memoryEvictions += evicted.count }
     }
     
     private func startCleanupTimer() {
@@ -238,39 +401,45 @@ private struct CacheMetrics {
     }
     
     private func cleanupExpiredItems() {
-        cacheQueue.async { [weak self] in
+        diskQueue.async { [weak self] in
             guard let self = self else { return }
             
-            let cachePath = NSSearchPathForDirectoriesInDomains(.cachesDirectory, .userDomainMask, true).first!
-            let diskCachePath = (cachePath as NSString).appendingPathComponent(DISK_CACHE_PATH)
-            
-            guard let files = try? self.fileManager.contentsOfDirectory(atPath: diskCachePath) else { return }
-            
-            for file in files {
-                let filePath = (diskCachePath as NSString).appendingPathComponent(file)
-                guard let attributes = try? self.fileManager.attributesOfItem(atPath: filePath),
-                      let creationDate = attributes[.creationDate] as? Date else { continue }
-                
-                if Date().timeIntervalSince(creationDate) > CacheConfig.videoContent {
-                    try? self.fileManager.removeItem(atPath: filePath)
-                    self.cacheMetrics.evictions += 1
-                }
-            }
+            // Maintenance runs on the disk queue, so compaction never races a write
+            let removed = self.diskTier.removeExpired()
+            self.recordMetrics { $0.evictions += removed }
             
             Logger.shared.debug("Completed cache cleanup")
         }
     }
 }
 
-// MARK: - String Extension
-private extension String {
-    var md5: String {
-        let data = Data(self.utf8)
-        let hash = data.withUnsafeBytes { (bytes: UnsafeRawBufferPointer) -> [UInt8] in
-            var hash = [UInt8](repeating: 0, count: Int(CC_MD5_DIGEST_LENGTH))
-            CC_MD5(bytes.baseAddress, CC_LONG(data.count), &hash)
-            return hash
+// MARK: - Memory Pressure
+extension CacheManager: MemoryPressureParticipant {
+    public func trimMemory(fraction: Double, level: MemoryPressureLevel) {
+        let targetCost = Int(Double(memoryCache.totalCost) * (1 - fraction))
+        let evicted = memoryCache.trim(toCost: targetCost)
+        recordMetrics { $0.memoryEvictions += evicted }
+        Logger.shared.debug("Trimmed \(evicted) memory cache entries under memory pressure")
+    }
+}
+
+// MARK: - Performance Profile
+extension CacheManager: PerformanceProfileObserver {
+    /// 50MB at the full level, 32MB at reduced and about 16MB at minimal
+    static func memoryCostLimit(for profile: PerformanceProfile) -> Int {
+        switch profile.level {
+        case .full: return MAX_MEMORY_COST
+        case .reduced: return MAX_MEMORY_COST * 16 / 25
+        case .minimal: return MAX_MEMORY_COST / 3
         }
-        return hash.map { String(format: "%02x", $0) }.joined()
     }
-}
\ No newline at end of file
+    
+    public func performanceProfileDidChange(_ profile: PerformanceProfile) {
+        let costLimit = CacheManager.memoryCostLimit(for: profile)
+        guard costLimit != memoryCache.costLimit else { return }
+        
+        let evicted = memoryCache.setCostLimit(costLimit)
+        recordMetrics { $0.memoryEvictions += evicted }
+        Logger.shared.debug("Memory cache budget set to \(costLimit / 1024 / 1024)MB, evicted \(evicted) entries")
+    }
+}
@@ -24,11 +24,10 @@ typedef NS_ENUM(NSInteger, CacheManagerErrorCode) {
     CacheManagerErrorClearFailed = 1005
 };
 
+// Thread safety is provided by the Swift CacheManager's reader/writer queue,
+// so bridge methods call straight through without their own dispatch queue.
 @interface CacheManagerBridge : NSObject <RCTBridgeModule>
 
-// Dedicated serial queue for thread-safe cache operations
-@property(nonatomic, strong) dispatch_queue_t cacheQueue;
-
 /**
  * Stores data in cache with specified key and TTL
  * @param key Unique identifier for cached data
@@ -53,6 +52,28 @@ typedef NS_ENUM(NSInteger, CacheManagerErrorCode) {
        resolve:(RCTPromiseResolveBlock)resolve
         reject:(RCTPromiseRejectBlock)reject;
 
+/**
+ * Stores several entries in one call sharing a single TTL
+ * @param entries Binary data to cache, keyed by unique identifier
+ * @param ttl Time-to-live in seconds
+ * @param resolve Promise resolution callback
+ * @param reject Promise rejection callback
+ */
+- (void)setMany:(NSDictionary<NSString *, NSData *> * _Nonnull)entries
+            ttl:(NSNumber * _Nonnull)ttl
+        resolve:(RCTPromiseResolveBlock)resolve
+         reject:(RCTPromiseRejectBlock)reject;
+
+/**
+ * Retrieves several entries in one call
+ * @param keys Unique identifiers for cached data
+ * @param resolve Promise resolution callback receiving a dictionary of hits; misses are omitted
+ * @param reject Promise rejection callback
+ */
+- (void)getMany:(NSArray<NSString *> * _Nonnull)keys
+        resolve:(RCTPromiseResolveBlock)resolve
+         reject:(RCTPromiseRejectBlock)reject;
+
 /**
  * Removes data from cache by key
  * @param key Unique identifier for cached data
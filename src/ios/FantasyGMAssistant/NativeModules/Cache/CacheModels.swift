@@ -0,0 +1,87 @@
+//
+// CacheModels.swift
+// FantasyGMAssistant
+//
+// Shared types for the hybrid memory and disk cache
+// Version: 1.0.0
+//
+
+import Foundation // iOS 14.0+
+
+// MARK: - Cacheable Protocol
+public protocol Cacheable {
+    var cacheKey: String { get }
+    var expiryDate: Date { get }
+    var dataVersion: String { get }
+    
+    func toCacheData() throws -> Data
+    static func fromCacheData(_ data: Data) throws -> Self?
+}
+
+// MARK: - Cache Entry
+final class CacheEntry: NSObject {
+    /// Stored bytes, compressed when `flags` says so; this is what both tiers are charged for
+    let data: Data
+    let expiryDate: Date
+    let version: String
+    let flags: CacheRecordFlags
+    let createdAt: Date
+    
+    init(data: Data, expiryDate: Date, version: String, flags: CacheRecordFlags = []) {
+        self.data = data
+        self.expiryDate = expiryDate
+        self.version = version
+        self.flags = flags
+        self.createdAt = Date()
+        super.init()
+    }
+    
+    /// Original payload, decompressed if needed
+    func payload() throws -> Data {
+        return try CacheCodec.decode(data, flags: flags)
+    }
+}
+
+// MARK: - Pending Writes
+/// Entries already in memory whose disk write has not landed. Lookups that miss memory check here
+/// before disk, so an entry evicted early never falls back to the record it is replacing.
+final class CachePendingWrites {
+    private let lock = NSLock()
+    private var entries: [String: CacheEntry] = [:]
+    
+    func add(_ batch: [(key: String, entry: CacheEntry)]) {
+        lock.lock()
+        defer { lock.unlock() }
+        batch.forEach { entries[$0.key] = $0.entry }
+    }
+    
+    func entry(forKey key: String) -> CacheEntry? {
+        lock.lock()
+        defer { lock.unlock() }
+        return entries[key]
+    }
+    
+    /// Drops the batch once written, keeping any key a later store has replaced since
+    func finish(_ batch: [(key: String, entry: CacheEntry)]) {
+        lock.lock()
+        defer { lock.unlock() }
+        for item in batch where entries[item.key] === item.entry {
+            entries.removeValue(forKey: item.key)
+        }
+    }
+}
+
+// MARK: - Cache Metrics
+public struct CacheMetrics {
+    public var hits: Int = 0
+    public var misses: Int = 0
+    public var diskWrites: Int = 0
+    /// Disk records removed by expiry or by the size budget
+    public var evictions: Int = 0
+    /// Memory entries dropped by the memory budget
+    public var memoryEvictions: Int = 0
+    /// Bytes held on disk, bounded by `MAX_CACHE_SIZE_MB`
+    public var size: Int = 0
+    /// Bytes held in memory, bounded by `MAX_MEMORY_COST`
+    public var memorySize: Int = 0
+}
@@ -0,0 +1,384 @@
+//
+// CachePackStore.swift
+// FantasyGMAssistant
+//
+// Append-only, memory-mapped pack file backend for the disk cache
+// Version: 1.0.0
+//
+
+import Foundation // iOS 14.0+
+
+// MARK: - Pack Constants
+private let PACK_FILE_NAME = "cache.pack"
+private let COMPACTION_MIN_DEAD_BYTES = 4 * 1024 * 1024 // 4MB
+private let COMPACTION_DEAD_RATIO = 0.5
+private let COMPACTION_WRITE_CHUNK = 1024 * 1024 // 1MB
+
+// MARK: - Mapped Region
+/// Read-only mapping of the pack file. Payload slices retain the region,
+/// so a remap or compaction never invalidates data already handed out.
+private final class MappedRegion {
+    let base: UnsafeRawPointer
+    let length: Int
+    
+    init?(fileDescriptor: Int32, length: Int) {
+        guard length > 0,
+              let pointer = mmap(nil, length, PROT_READ, MAP_SHARED, fileDescriptor, 0),
+              pointer != UnsafeMutableRawPointer(bitPattern: -1) else {
+            return nil
+        }
+        
+        self.base = UnsafeRawPointer(pointer)
+        self.length = length
+    }
+    
+    func bytes(at offset: Int, count: Int) -> UnsafeRawBufferPointer {
+        return UnsafeRawBufferPointer(start: base + offset, count: count)
+    }
+    
+    /// Zero-copy `Data` view over part of the mapping
+    func slice(at offset: Int, count: Int) -> Data {
+        guard count > 0 else { return Data() }
+        
+        return Data(bytesNoCopy: UnsafeMutableRawPointer(mutating: base + offset),
+                    count: count,
+                    deallocator: .custom { _, _ in withExtendedLifetime(self) {} })
+    }
+    
+    deinit {
+        munmap(UnsafeMutableRawPointer(mutating: base), length)
+    }
+}
+
+// MARK: - Pack Store
+/// Records are appended as `[key length: UInt16][key: UTF-8][CacheRecordHeader][payload]`.
+/// An in-memory index maps each key to its latest record; removals append a tombstone.
+/// Writes, removals and compaction must be serialized by the caller; reads may run concurrently.
+final class CachePackStore: DiskCacheStore {
+    private struct Slot {
+        let header: CacheRecordHeader
+        let recordOffset: Int
+        let payloadOffset: Int
+        let recordLength: Int
+        var verified: Bool
+    }
+    
+    private static let tombstone = CacheRecordHeader(payload: Data(), expiryDate: .distantPast,
+                                                     version: "", flags: .tombstone)
+    
+    private let packURL: URL
+    private let lock = NSLock()
+    private var fileHandle: FileHandle
+    private var index: [String: Slot] = [:]
+    private var region: MappedRegion?
+    private var fileLength: Int = 0
+    private var deadBytes: Int = 0
+    
+    init?(directory: String) {
+        let fileManager = FileManager.default
+        if !fileManager.fileExists(atPath: directory) {
+            try? fileManager.createDirectory(atPath: directory, withIntermediateDirectories: true)
+        }
+        
+        packURL = URL(fileURLWithPath: directory).appendingPathComponent(PACK_FILE_NAME)
+        if !fileManager.fileExists(atPath: packURL.path) {
+            guard fileManager.createFile(atPath: packURL.path, contents: nil) else { return nil }
+        }
+        
+        guard let handle = try? FileHandle(forUpdating: packURL) else { return nil }
+        fileHandle = handle
+        
+        rebuildIndex()
+    }
+    
+    deinit {
+        try? fileHandle.close()
+    }
+    
+    // MARK: - DiskCacheStore
+    func header(for key: String) -> CacheRecordHeader? {
+        lock.lock()
+        defer { lock.unlock() }
+        return index[key]?.header
+    }
+    
+    func record(for key: String) throws -> (header: CacheRecordHeader, payload: Data)? {
+        lock.lock()
+        guard let slot = index[key], let region = regionCovering(slot.payloadOffset + slot.header.payloadLength) else {
+            lock.unlock()
+            return nil
+        }
+        lock.unlock()
+        
+        let payload = region.slice(at: slot.payloadOffset, count: slot.header.payloadLength)
+        
+        // Verify each record once; later hits return the slice without touching every page
+        if !slot.verified {
+            guard CacheRecord.checksum(payload) == slot.header.checksum else {
+                throw CacheRecordError.checksumMismatch
+            }
+            markVerified(key, recordOffset: slot.recordOffset)
+        }
+        
+        return (slot.header, payload)
+    }
+    
+    func write(_ payload: Data, header: CacheRecordHeader, for key: String) throws {
+        try write([(key, header, payload)])
+    }
+    
+    /// Appends every record with a single write, then publishes them to the index together
+    func write(_ records: [DiskCacheRecord]) throws {
+        var buffer = Data()
+        var layout: [(record: DiskCacheRecord, start: Int, length: Int, payloadStart: Int)] = []
+        
+        for record in records {
+            let keyBytes = Array(record.key.utf8)
+            guard keyBytes.count <= Int(UInt16.max) else { throw CacheRecordError.invalidHeader }
+            
+            let start = buffer.count
+            withUnsafeBytes(of: UInt16(keyBytes.count).littleEndian) { buffer.append(contentsOf: $0) }
+            buffer.append(contentsOf: keyBytes)
+            buffer.append(record.header.encoded())
+            let payloadStart = buffer.count
+            buffer.append(record.payload)
+            layout.append((record, start, buffer.count - start, payloadStart))
+        }
+        
+        // Appends happen outside the lock; only the index update blocks readers
+        let offset = Int(try fileHandle.seekToEnd())
+        try fileHandle.write(contentsOf: buffer)
+        
+        lock.lock()
+        defer { lock.unlock() }
+        
+        fileLength = offset + buffer.count
+        for item in layout {
+            let key = item.record.key
+            if item.record.header.flags.contains(.tombstone) {
+                deadBytes += item.length
+                if let previous = index.removeValue(forKey: key) {
+                    deadBytes += previous.recordLength
+                }
+                continue
+            }
+            
+            let slot = Slot(header: item.record.header,
+                            recordOffset: offset + item.start,
+                            payloadOffset: offset + item.payloadStart,
+                            recordLength: item.length,
+                            verified: true)
+            if let previous = index.updateValue(slot, forKey: key) {
+                deadBytes += previous.recordLength
+            }
+        }
+    }
+    
+    func remove(_ key: String) {
+        lock.lock()
+        let exists = index[key] != nil
+        lock.unlock()
+        guard exists else { return }
+        
+        do {
+            try write(Data(), header: Self.tombstone, for: key)
+        } catch {
+            Logger.shared.error("Failed to append cache tombstone", error: error)
+        }
+    }
+    
+    func removeAll() {
+        // Replace the file instead of truncating it: payload slices still held by callers
+        // keep the old inode mapped, and truncation would fault them with SIGBUS
+        let emptyURL = packURL.appendingPathExtension("empty")
+        guard FileManager.default.createFile(atPath: emptyURL.path, contents: nil),
+              rename(emptyURL.path, packURL.path) == 0,
+              let handle = try? FileHandle(forUpdating: packURL) else {
+            Logger.shared.error("Failed to reset cache pack")
+            return
+        }
+        
+        lock.lock()
+        defer { lock.unlock() }
+        
+        try? fileHandle.close()
+        fileHandle = handle
+        index.removeAll()
+        region = nil
+        fileLength = 0
+        deadBytes = 0
+    }
+    
+    /// Tombstones expired records in one append, so the index rebuilt at the next launch
+    /// does not bring them back to be served as stale; compaction reclaims their bytes
+    func removeExpired(version: String, now: Date) -> Int {
+        lock.lock()
+        let expired = index.filter { !$0.value.header.isLive(version: version, at: now) }.map { $0.key }
+        lock.unlock()
+        guard !expired.isEmpty else { return 0 }
+        
+        do {
+            try write(expired.map { ($0, Self.tombstone, Data()) })
+        } catch {
+            Logger.shared.error("Failed to append cache tombstones", error: error)
+            return 0
+        }
+        return expired.count
+    }
+    
+    func storedEntries() -> [(key: String, header: CacheRecordHeader)] {
+        lock.lock()
+        defer { lock.unlock() }
+        
+        return index
+            .sorted { $0.value.recordOffset < $1.value.recordOffset }
+            .map { ($0.key, $0.value.header) }
+    }
+    
+    var reclaimableBytes: Int {
+        lock.lock()
+        defer { lock.unlock() }
+        return deadBytes
+    }
+    
+    /// Compacts once enough of the file is dead to be worth the copy
+    func compactIfNeeded() {
+        lock.lock()
+        let shouldCompact = deadBytes >= COMPACTION_MIN_DEAD_BYTES &&
+            Double(deadBytes) >= Double(fileLength) * COMPACTION_DEAD_RATIO
+        lock.unlock()
+        
+        if shouldCompact {
+            compact()
+        }
+    }
+    
+    /// Rewrites live records into a fresh pack.
+    /// Readers keep using the old mapping until the swap, so only the final swap takes the lock.
+    func compact() {
+        lock.lock()
+        let liveIndex = index
+        let source = regionCovering(fileLength)
+        let hasDeadBytes = deadBytes > 0
+        lock.unlock()
+        
+        guard hasDeadBytes, let source = source else { return }
+        
+        let compactURL = packURL.appendingPathExtension("compact")
+        FileManager.default.createFile(atPath: compactURL.path, contents: nil)
+        
+        do {
+            let output = try FileHandle(forWritingTo: compactURL)
+            var newIndex: [String: Slot] = [:]
+            var buffer = Data(capacity: COMPACTION_WRITE_CHUNK)
+            var written = 0
+            
+            // Copy records in file order so the new pack preserves append order
+            for (key, slot) in liveIndex.sorted(by: { $0.value.recordOffset < $1.value.recordOffset }) {
+                buffer.append(contentsOf: source.bytes(at: slot.recordOffset, count: slot.recordLength))
+                newIndex[key] = Slot(header: slot.header,
+                                     recordOffset: written,
+                                     payloadOffset: written + (slot.payloadOffset - slot.recordOffset),
+                                     recordLength: slot.recordLength,
+                                     verified: slot.verified)
+                written += slot.recordLength
+                
+                if buffer.count >= COMPACTION_WRITE_CHUNK {
+                    try output.write(contentsOf: buffer)
+                    buffer.removeAll(keepingCapacity: true)
+                }
+            }
+            
+            try output.write(contentsOf: buffer)
+            try output.close()
+            
+            guard rename(compactURL.path, packURL.path) == 0 else {
+                throw CocoaError(.fileWriteUnknown)
+            }
+            
+            let handle = try FileHandle(forUpdating: packURL)
+            
+            lock.lock()
+            try? fileHandle.close()
+            fileHandle = handle
+            index = newIndex
+            region = nil
+            fileLength = written
+            deadBytes = 0
+            lock.unlock()
+            
+            Logger.shared.debug("Compacted cache pack to \(written) bytes")
+        } catch {
+            try? FileManager.default.removeItem(at: compactURL)
+            Logger.shared.error("Cache pack compaction failed", error: error)
+        }
+    }
+    
+    // MARK: - Private Methods
+    /// Returns a mapping that covers `length` bytes, remapping after appends. Must hold `lock`.
+    private func regionCovering(_ length: Int) -> MappedRegion? {
+        if let region = region, region.length >= length {
+            return region
+        }
+        
+        region = MappedRegion(fileDescriptor: fileHandle.fileDescriptor, length: fileLength)
+        return region
+    }
+    
+    private func markVerified(_ key: String, recordOffset: Int) {
+        lock.lock()
+        defer { lock.unlock() }
+        
+        // Skip if the key was rewritten or compacted since the slot was read
+        if index[key]?.recordOffset == recordOffset {
+            index[key]?.verified = true
+        }
+    }
+    
+    /// Scans record headers through the mapping to rebuild the index; payloads are not read.
+    /// A torn record at the tail (e.g. from a crash mid-append) is truncated away.
+    private func rebuildIndex() {
+        let length = Int((try? fileHandle.seekToEnd()) ?? 0)
+        fileLength = length
+        guard let region = regionCovering(length) else { return }
+        
+        var offset = 0
+        while offset + 2 <= length {
+            let keyLength = Int(UInt16(littleEndian: region.bytes(at: offset, count: 2).loadUnaligned(as: UInt16.self)))
+            let headerOffset = offset + 2 + keyLength
+            
+            guard headerOffset + CacheRecordHeader.size <= length,
+                  let header = try? CacheRecordHeader(bytes: region.bytes(at: headerOffset,
+                                                                          count: CacheRecordHeader.size)),
+                  headerOffset + CacheRecordHeader.size + header.payloadLength <= length else {
+                break
+            }
+            
+            let key = String(decoding: region.bytes(at: offset + 2, count: keyLength), as: UTF8.self)
+            let recordLength = 2 + keyLength + CacheRecordHeader.size + header.payloadLength
+            
+            if let previous = index.removeValue(forKey: key) {
+                deadBytes += previous.recordLength
+            }
+            
+            if header.flags.contains(.tombstone) {
+                deadBytes += recordLength
+            } else {
+                index[key] = Slot(header: header,
+                                  recordOffset: offset,
+                                  payloadOffset: headerOffset + CacheRecordHeader.size,
+                                  recordLength: recordLength,
+                                  verified: false)
+            }
+            
+            offset += recordLength
+        }
+        
+        if offset < length {
+            Logger.shared.error("Truncating \(length - offset) torn bytes from cache pack")
+            try? fileHandle.truncate(atOffset: UInt64(offset))
+            fileLength = offset
+            self.region = nil
+        }
+    }
+}
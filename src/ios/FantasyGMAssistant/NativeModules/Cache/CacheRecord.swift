@@ -0,0 +1,157 @@
+//
+// CacheRecord.swift
+// FantasyGMAssistant
+//
+// Compact binary record format for the disk cache
+// Version: 1.0.0
+//
+
+import Foundation // iOS 14.0+
+
+// MARK: - Record Constants
+private let RECORD_MAGIC: UInt32 = 0x434D_4746 // "FGMC" little-endian
+private let RECORD_FORMAT_VERSION: UInt8 = 1
+private let RECORD_VERSION_FIELD_SIZE = 8
+
+// MARK: - Record Errors
+enum CacheRecordError: Error {
+    case truncated
+    case invalidHeader
+    case checksumMismatch
+}
+
+// MARK: - Record Flags
+struct CacheRecordFlags: OptionSet {
+    let rawValue: UInt8
+    
+    /// Payload is LZ4 compressed
+    static let lz4 = CacheRecordFlags(rawValue: 1 << 0)
+    /// Payload is LZFSE compressed
+    static let lzfse = CacheRecordFlags(rawValue: 1 << 1)
+    /// Marks a deleted key in append-only stores
+    static let tombstone = CacheRecordFlags(rawValue: 1 << 7)
+}
+
+// MARK: - Record Header
+/// Fixed 32-byte little-endian header written in front of every cached payload.
+///
+///     offset  size  field
+///     0       4     magic ("FGMC")
+///     4       1     format version
+///     5       1     flags
+///     6       2     reserved
+///     8       8     expiry (seconds since 1970, Float64)
+///     16      8     data version (UTF-8, zero padded)
+///     24      4     payload checksum (FNV-1a)
+///     28      4     payload length
+struct CacheRecordHeader {
+    static let size = 32
+    
+    let flags: CacheRecordFlags
+    let expiryDate: Date
+    let version: String
+    let checksum: UInt32
+    let payloadLength: Int
+    
+    init(payload: Data, expiryDate: Date, version: String, flags: CacheRecordFlags = []) {
+        self.flags = flags
+        self.expiryDate = expiryDate
+        self.version = version
+        self.checksum = CacheRecord.checksum(payload)
+        self.payloadLength = payload.count
+    }
+    
+    /// Decodes a header from the first `CacheRecordHeader.size` bytes of a record
+    init(bytes: UnsafeRawBufferPointer) throws {
+        guard bytes.count >= CacheRecordHeader.size else { throw CacheRecordError.truncated }
+        guard UInt32(littleEndian: bytes.loadUnaligned(fromByteOffset: 0, as: UInt32.self)) == RECORD_MAGIC,
+              bytes[4] == RECORD_FORMAT_VERSION else {
+            throw CacheRecordError.invalidHeader
+        }
+        
+        let expiryBits = UInt64(littleEndian: bytes.loadUnaligned(fromByteOffset: 8, as: UInt64.self))
+        let versionBytes = bytes[16..<(16 + RECORD_VERSION_FIELD_SIZE)].prefix { $0 != 0 }
+        
+        flags = CacheRecordFlags(rawValue: bytes[5])
+        expiryDate = Date(timeIntervalSince1970: Double(bitPattern: expiryBits))
+        version = String(decoding: versionBytes, as: UTF8.self)
+        checksum = UInt32(littleEndian: bytes.loadUnaligned(fromByteOffset: 24, as: UInt32.self))
+        payloadLength = Int(UInt32(littleEndian: bytes.loadUnaligned(fromByteOffset: 28, as: UInt32.self)))
+    }
+    
+    init(data: Data) throws {
+        self = try data.withUnsafeBytes { try CacheRecordHeader(bytes: $0) }
+    }
+    
+    func encoded() -> Data {
+        var data = Data(capacity: CacheRecordHeader.size)
+        withUnsafeBytes(of: RECORD_MAGIC.littleEndian) { data.append(contentsOf: $0) }
+        data.append(RECORD_FORMAT_VERSION)
+        data.append(flags.rawValue)
+        data.append(contentsOf: [0, 0])
+        withUnsafeBytes(of: expiryDate.timeIntervalSince1970.bitPattern.littleEndian) { data.append(contentsOf: $0) }
+        
+        var versionField = Array(version.utf8.prefix(RECORD_VERSION_FIELD_SIZE))
+        versionField += Array(repeating: 0, count: RECORD_VERSION_FIELD_SIZE - versionField.count)
+        data.append(contentsOf: versionField)
+        
+        withUnsafeBytes(of: checksum.littleEndian) { data.append(contentsOf: $0) }
+        withUnsafeBytes(of: UInt32(payloadLength).littleEndian) { data.append(contentsOf: $0) }
+        return data
+    }
+    
+    /// True when the record has not expired and was written by the given data version
+    func isLive(version currentVersion: String, at date: Date = Date()) -> Bool {
+        return expiryDate > date && version == currentVersion
+    }
+}
+
+// MARK: - Record Encoding
+enum CacheRecord {
+    static func encode(payload: Data, header: CacheRecordHeader) -> Data {
+        var record = header.encoded()
+        record.append(payload)
+        return record
+    }
+    
+    /// Splits a full record into its header and payload, verifying length and checksum.
+    /// The returned payload is a slice of `record` and does not copy.
+    static func decode(_ record: Data) throws -> (header: CacheRecordHeader, payload: Data) {
+        let header = try CacheRecordHeader(data: record)
+        let start = record.startIndex + CacheRecordHeader.size
+        
+        guard record.count - CacheRecordHeader.size >= header.payloadLength else {
+            throw CacheRecordError.truncated
+        }
+        
+        let payload = record[start..<(start + header.payloadLength)]
+        guard checksum(payload) == header.checksum else {
+            throw CacheRecordError.checksumMismatch
+        }
+        
+        return (header, payload)
+    }
+    
+    /// Reads only the fixed header of a record file
+    static func readHeader(at url: URL) throws -> CacheRecordHeader {
+        let handle = try FileHandle(forReadingFrom: url)
+        defer { try? handle.close() }
+        
+        guard let bytes = try handle.read(upToCount: CacheRecordHeader.size) else {
+            throw CacheRecordError.truncated
+        }
+        return try CacheRecordHeader(data: bytes)
+    }
+    
+    /// 32-bit FNV-1a over the payload bytes
+    static func checksum(_ data: Data) -> UInt32 {
+        return data.withUnsafeBytes { bytes -> UInt32 in
+            var hash: UInt32 = 0x811C_9DC5
+            for byte in bytes {
+                hash ^= UInt32(byte)
+                hash = hash &* 0x0100_0193
+            }
+            return hash
+        }
+    }
+}
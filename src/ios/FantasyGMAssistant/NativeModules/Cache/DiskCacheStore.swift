@@ -0,0 +1,189 @@
+//
+// DiskCacheStore.swift
+// FantasyGMAssistant
+//
+// Disk tier storage backends for CacheManager
+// Version: 1.0.0
+//
+
+import Foundation // iOS 14.0+
+
+// MARK: - Disk Backend Selection
+enum DiskCacheBackend {
+    /// One record file per key
+    case files
+    /// Single append-only, memory-mapped pack file
+    case packFile
+    
+    /// Opens the backend, falling back to per-file records if the pack cannot be opened
+    func makeStore(directory: String, fileManager: FileManager = .default) -> DiskCacheStore {
+        let fileStore = FileDiskCacheStore(directory: directory, fileManager: fileManager)
+        guard self == .packFile else { return fileStore }
+        
+        guard let packStore = CachePackStore(directory: directory) else {
+            Logger.shared.error("Failed to open cache pack, using per-file records")
+            return fileStore
+        }
+        
+        // Records written by the per-file backend are not migrated; the cache refills on demand
+        fileStore.removeAll()
+        return packStore
+    }
+}
+
+/// A record queued for a batched disk write
+typealias DiskCacheRecord = (key: String, header: CacheRecordHeader, payload: Data)
+
+// MARK: - Disk Cache Store Protocol
+/// Storage contract for the disk tier. Reads may run concurrently; writes, removals
+/// and maintenance are serialized by the caller.
+protocol DiskCacheStore: AnyObject {
+    /// Header of the stored record, used for expiry/version checks without loading the payload
+    func header(for key: String) -> CacheRecordHeader?
+    
+    /// Full record with a checksum-verified payload
+    func record(for key: String) throws -> (header: CacheRecordHeader, payload: Data)?
+    
+    func write(_ payload: Data, header: CacheRecordHeader, for key: String) throws
+    
+    /// Writes several records, grouping the I/O where the backend allows it
+    func write(_ records: [DiskCacheRecord]) throws
+    func remove(_ key: String)
+    func removeAll()
+    
+    /// Drops expired and stale-version records, returning the number removed
+    func removeExpired(version: String, now: Date) -> Int
+    
+    /// Keys and headers of stored records, oldest write first, used to seed the size budget
+    func storedEntries() -> [(key: String, header: CacheRecordHeader)]
+    
+    /// Bytes still held on disk by overwritten and removed records
+    var reclaimableBytes: Int { get }
+    
+    /// Reclaims space left by overwritten and removed records when worthwhile
+    func compactIfNeeded()
+    
+    /// Reclaims all such space now
+    func compact()
+}
+
+extension DiskCacheStore {
+    func write(_ records: [DiskCacheRecord]) throws {
+        for record in records {
+            try write(record.payload, header: record.header, for: record.key)
+        }
+    }
+    
+    var reclaimableBytes: Int {
+        return 0
+    }
+    
+    func compactIfNeeded() {}
+    
+    func compact() {}
+}
+
+// MARK: - File Store
+/// Stores each record in its own file named after a 64-bit hash of the key, with the key
+/// itself trailing the payload so records from earlier launches can be charged to the budget.
+final class FileDiskCacheStore: DiskCacheStore {
+    private let directory: String
+    private let directoryURL: URL
+    private let fileManager: FileManager
+    
+    init(directory: String, fileManager: FileManager = .default) {
+        self.directory = directory
+        self.directoryURL = URL(fileURLWithPath: directory, isDirectory: true)
+        self.fileManager = fileManager
+        
+        if !fileManager.fileExists(atPath: directory) {
+            try? fileManager.createDirectory(atPath: directory, withIntermediateDirectories: true)
+        }
+    }
+    
+    func header(for key: String) -> CacheRecordHeader? {
+        return try? CacheRecord.readHeader(at: url(for: key))
+    }
+    
+    func record(for key: String) throws -> (header: CacheRecordHeader, payload: Data)? {
+        let url = self.url(for: key)
+        guard fileManager.fileExists(atPath: url.path) else { return nil }
+        
+        return try CacheRecord.decode(Data(contentsOf: url, options: .mappedIfSafe))
+    }
+    
+    func write(_ payload: Data, header: CacheRecordHeader, for key: String) throws {
+        var record = CacheRecord.encode(payload: payload, header: header)
+        record.append(contentsOf: key.utf8)
+        try record.write(to: url(for: key), options: .atomic)
+    }
+    
+    func remove(_ key: String) {
+        try? fileManager.removeItem(at: url(for: key))
+    }
+    
+    func removeAll() {
+        recordFiles().forEach { try? fileManager.removeItem(atPath: $0) }
+    }
+    
+    func removeExpired(version: String, now: Date) -> Int {
+        var removed = 0
+        
+        for filePath in recordFiles() {
+            // Header-only check; unreadable files are treated as expired
+            let header = try? CacheRecord.readHeader(at: URL(fileURLWithPath: filePath))
+            if header?.isLive(version: version, at: now) != true {
+                try? fileManager.removeItem(atPath: filePath)
+                removed += 1
+            }
+        }
+        
+        return removed
+    }
+    
+    /// Reads each file's header and key trailer, oldest modification first. Files with no
+    /// recoverable key could never be charged to the budget, so they are removed.
+    func storedEntries() -> [(key: String, header: CacheRecordHeader)] {
+        let dated = recordFiles().map { path -> (path: String, modified: Date) in
+            let attributes = try? fileManager.attributesOfItem(atPath: path)
+            return (path, attributes?[.modificationDate] as? Date ?? .distantPast)
+        }
+        
+        var entries: [(key: String, header: CacheRecordHeader)] = []
+        for file in dated.sorted(by: { $0.modified < $1.modified }) {
+            if let entry = try? storedEntry(at: URL(fileURLWithPath: file.path)) {
+                entries.append(entry)
+            } else {
+                try? fileManager.removeItem(atPath: file.path)
+            }
+        }
+        return entries
+    }
+    
+    // MARK: - Private Methods
+    private func url(for key: String) -> URL {
+        return directoryURL.appendingPathComponent(CacheKeyHash.fileName(for: key), isDirectory: false)
+    }
+    
+    /// nil when the file has no key trailer or the key does not hash to the file's name
+    private func storedEntry(at url: URL) throws -> (key: String, header: CacheRecordHeader)? {
+        let handle = try FileHandle(forReadingFrom: url)
+        defer { try? handle.close() }
+        
+        guard let headerBytes = try handle.read(upToCount: CacheRecordHeader.size) else { return nil }
+        let header = try CacheRecordHeader(data: headerBytes)
+        try handle.seek(toOffset: UInt64(CacheRecordHeader.size + header.payloadLength))
+        
+        guard let keyBytes = try handle.readToEnd(), !keyBytes.isEmpty else { return nil }
+        let key = String(decoding: keyBytes, as: UTF8.self)
+        return CacheKeyHash.fileName(for: key) == url.lastPathComponent ? (key, header) : nil
+    }
+    
+    /// Record files are named by key hash and have no extension, which keeps pack files out of the listing
+    private func recordFiles() -> [String] {
+        guard let files = try? fileManager.contentsOfDirectory(atPath: directory) else { return [] }
+        return files
+            .filter { ($0 as NSString).pathExtension.isEmpty }
+            .map { (directory as NSString).appendingPathComponent($0) }
+    }
+}
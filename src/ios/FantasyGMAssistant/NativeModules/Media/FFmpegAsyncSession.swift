@@ -0,0 +1,97 @@
+//
+// FFmpegAsyncSession.swift
+// FantasyGMAssistant
+//
+// Cancellable async wrapper around FFmpegKit sessions with encode statistics
+// Version: 1.0.0
+//
+
+import Foundation // iOS 14.0+
+import FFmpegKit // v5.1
+
+// MARK: - Encode Statistics
+public struct FFmpegStatistics {
+    /// Output position reached so far
+    public let time: TimeInterval
+    public let fps: Double
+    /// Current output bitrate in kbit/s
+    public let bitrate: Double
+    
+    init(_ statistics: Statistics) {
+        time = statistics.getTime() / 1000
+        fps = Double(statistics.getVideoFps())
+        bitrate = statistics.getBitrate()
+    }
+    
+    /// Share of an output of `duration` seconds written so far
+    public func fraction(of duration: TimeInterval) -> Double {
+        guard duration > 0 else { return 0 }
+        return min(max(time / duration, 0), 1)
+    }
+}
+
+// MARK: - Async Session
+/// Runs one FFmpeg command without blocking a thread. Cancelling the calling task cancels the
+/// FFmpeg session, and the call then throws `CancellationError`.
+enum FFmpegAsyncSession {
+    static func execute(_ command: String,
+                        statisticsHandler: ((FFmpegStatistics) -> Void)? = nil) async throws {
+        let handle = SessionHandle()
+        
+        try await withTaskCancellationHandler {
+            try await withCheckedThrowingContinuation { (continuation: CheckedContinuation<Void, Error>) in
+                let session = FFmpegKit.executeAsync(command, withCompleteCallback: { session in
+                    guard let returnCode = session?.getReturnCode() else {
+                        continuation.resume(throwing: MediaError.processingFailed)
+                        return
+                    }
+                    
+                    if returnCode.isValueSuccess() {
+                        continuation.resume()
+                    } else if returnCode.isValueCancel() {
+                        continuation.resume(throwing: CancellationError())
+                    } else {
+                        continuation.resume(throwing: MediaError.processingFailed)
+                    }
+                }, withLogCallback: nil, withStatisticsCallback: { statistics in
+                    guard let statistics = statistics else { return }
+                    statisticsHandler?(FFmpegStatistics(statistics))
+                })
+                
+                handle.attach(session?.getSessionId())
+            }
+        } onCancel: {
+            handle.cancel()
+        }
+    }
+    
+    /// Session ID shared between the starting task and its cancellation handler, which can run
+    /// before the session exists
+    private final class SessionHandle {
+        private let lock = NSLock()
+        private var sessionID: Int?
+        private var isCancelled = false
+        
+        func attach(_ id: Int?) {
+            lock.lock()
+            sessionID = id
+            let cancelNow = isCancelled
+            lock.unlock()
+            
+            if cancelNow, let id = id {
+                FFmpegKit.cancel(id)
+            }
+        }
+        
+        func cancel() {
+            lock.lock()
+            isCancelled = true
+            let id = sessionID
+            lock.unlock()
+            
+            if let id = id {
+                FFmpegKit.cancel(id)
+            }
+        }
+    }
+}
@@ -0,0 +1,218 @@
+//
+// MediaCache.swift
+// FantasyGMAssistant
+//
+// Content-addressed disk cache for synthesized voiceovers and rendered video segments
+// Version: 1.0.0
+//
+
+import Foundation // iOS 14.0+
+import CryptoKit // iOS 13.0+
+
+// MARK: - Media Cache Constants
+/// Bump when voice synthesis or segment templates change so stale renders are never reused
+private let MEDIA_CACHE_VERSION = "1"
+private let MEDIA_CACHE_DIRECTORY = "FantasyGM/Media"
+private let MEDIA_CACHE_BYTE_LIMIT = 200 * 1024 * 1024
+
+// MARK: - Media Cache
+/// Stores media files under the hash of what produced them, so an identical script or segment
+/// is synthesized or rendered once and then reused with no network or encode cost.
+/// Size is budgeted with the same LRU the CacheManager disk tier uses. Files are kept as plain
+/// media rather than cache records so FFmpeg and AVFoundation read them in place.
+///
+/// Callers never get the cache's own path. A hit is hard-linked into the caller's temporary file
+/// scope and a stored file stays at the caller's path, so replacing or evicting an entry only
+/// unlinks the cache's name while operations still reading the file keep their own link.
+final class MediaCache {
+    static let shared: MediaCache? = {
+        let caches = FileManager.default.urls(for: .cachesDirectory, in: .userDomainMask)[0]
+        return MediaCache(directory: caches.appendingPathComponent(MEDIA_CACHE_DIRECTORY),
+                          byteLimit: MEDIA_CACHE_BYTE_LIMIT)
+    }()
+    
+    private let directory: URL
+    private let registry: TemporaryFileRegistry
+    private let fileManager = FileManager.default
+    /// Cached file locations by file name, charged at file size, most recently used first
+    private let index: CacheLRU<URL>
+    private let lock = NSLock()
+    /// Callers waiting on a file another caller is producing, by file name
+    private var inFlight: [String: [CheckedContinuation<Bool, Never>]] = [:]
+    
+    init?(directory: URL, byteLimit: Int, registry: TemporaryFileRegistry = .shared) {
+        do {
+            try FileManager.default.createDirectory(at: directory, withIntermediateDirectories: true)
+        } catch {
+            Logger.shared.error("Failed to create media cache directory", error: error)
+            return nil
+        }
+        
+        self.directory = directory
+        self.registry = registry
+        self.index = CacheLRU<URL>(costLimit: byteLimit)
+        seed()
+    }
+    
+    // MARK: - Keys
+    static func voiceoverKey(text: String, quality: VoiceQuality, voiceID: String) -> String {
+        return digest(["voiceover", text, "\(quality)", voiceID])
+    }
+    
+    /// Parameters are serialized with sorted keys so equal dictionaries always hash the same.
+    /// Returns nil when they cannot be serialized, in which case the segment is not cached.
+    static func segmentKey(template: String, parameters: [String: Any]) -> String? {
+        guard JSONSerialization.isValidJSONObject(parameters),
+              let json = try? JSONSerialization.data(withJSONObject: parameters, options: [.sortedKeys]) else {
+            return nil
+        }
+        return digest(["segment", template, String(decoding: json, as: UTF8.self)])
+    }
+    
+    // MARK: - Access
+    /// Returns a link to the cached file held by the current temporary file scope, or nil on a
+    /// miss. The link outlives eviction; it shares the cached data, so it must not be modified.
+    func url(forKey key: String, fileExtension: String) -> URL? {
+        let name = key + "." + fileExtension
+        lock.lock()
+        defer { lock.unlock() }
+        
+        guard let url = index.value(forKey: name) else { return nil }
+        let link = registry.makeURL(pathExtension: fileExtension)
+        do {
+            try fileManager.linkItem(at: url, to: link)
+        } catch {
+            // Usually the file was deleted behind the cache's back; either way this is a miss
+            if !fileManager.fileExists(atPath: url.path) {
+                index.removeValue(forKey: name)
+            }
+            return nil
+        }
+        
+        // Recency survives relaunches through the modification date `seed` orders by
+        try? fileManager.setAttributes([.modificationDate: Date()], ofItemAtPath: url.path)
+        return link
+    }
+    
+    /// Links a freshly produced file into the cache and returns it at the caller's path, which
+    /// stays the caller's to hold. Evicts least recently used files over budget.
+    @discardableResult
+    func store(_ fileURL: URL, forKey key: String) -> URL {
+        let name = key + "." + fileURL.pathExtension
+        let cachedURL = directory.appendingPathComponent(name)
+        let size = (try? fileURL.resourceValues(forKeys: [.fileSizeKey]).fileSize) ?? 0
+        // The LRU would evict an oversized file straight away
+        guard size <= index.costLimit else { return fileURL }
+        
+        lock.lock()
+        defer { lock.unlock() }
+        
+        do {
+            // Readers of the entry being replaced hold links of their own
+            if fileManager.fileExists(atPath: cachedURL.path) {
+                try fileManager.removeItem(at: cachedURL)
+            }
+            try fileManager.linkItem(at: fileURL, to: cachedURL)
+        } catch {
+            Logger.shared.error("Failed to cache media file \(name)", error: error)
+            return fileURL
+        }
+        
+        evict(index.insert(cachedURL, forKey: name, cost: size))
+        return fileURL
+    }
+    
+    /// Serves the cached file for `key`, or produces it, caches it and returns it. Concurrent
+    /// calls for the same key wait for the first to finish and are then served from the cache;
+    /// if it failed, or its file could not be cached, the next waiter produces it instead.
+    func cachedOrProduce(_ key: String?,
+                         fileExtension: String,
+                         produce: () async throws -> URL) async throws -> URL {
+        guard let key = key else { return try await produce() }
+        let name = key + "." + fileExtension
+        
+        while true {
+            if let cached = url(forKey: key, fileExtension: fileExtension) {
+                return cached
+            }
+            guard await claimProduction(of: name) else { continue }
+            defer { finishProduction(of: name) }
+            
+            // Produced between the miss above and the claim
+            if let cached = url(forKey: key, fileExtension: fileExtension) {
+                return cached
+            }
+            return store(try await produce(), forKey: key)
+        }
+    }
+    
+    var totalBytes: Int {
+        return index.totalCost
+    }
+    
+    func removeAll() {
+        lock.lock()
+        defer { lock.unlock() }
+        
+        index.removeAll()
+        try? fileManager.removeItem(at: directory)
+        try? fileManager.createDirectory(at: directory, withIntermediateDirectories: true)
+    }
+    
+    // MARK: - Private Methods
+    private static func digest(_ components: [String]) -> String {
+        let material = ([MEDIA_CACHE_VERSION] + components).joined(separator: "\u{1F}")
+        let hash = SHA256.hash(data: Data(material.utf8))
+        return hash.prefix(16).map { String(format: "%02x", $0) }.joined()
+    }
+    
+    /// True when the caller should produce `name`. Otherwise waits for the caller producing it
+    /// and returns false, so the cache is checked again.
+    private func claimProduction(of name: String) async -> Bool {
+        return await withCheckedContinuation { continuation in
+            lock.lock()
+            if inFlight[name] == nil {
+                inFlight[name] = []
+                lock.unlock()
+                continuation.resume(returning: true)
+            } else {
+                inFlight[name]?.append(continuation)
+                lock.unlock()
+            }
+        }
+    }
+    
+    private func finishProduction(of name: String) {
+        lock.lock()
+        let waiters = inFlight.removeValue(forKey: name) ?? []
+        lock.unlock()
+        
+        waiters.forEach { $0.resume(returning: false) }
+    }
+    
+    /// Indexes files left by earlier launches, least recently used first
+    private func seed() {
+        let keys: [URLResourceKey] = [.fileSizeKey, .contentModificationDateKey]
+        let files = (try? fileManager.contentsOfDirectory(at: directory,
+                                                          includingPropertiesForKeys: keys,
+                                                          options: [.skipsHiddenFiles])) ?? []
+        let sorted = files.compactMap { url -> (url: URL, size: Int, date: Date)? in
+            guard let values = try? url.resourceValues(forKeys: Set(keys)) else { return nil }
+            return (url, values.fileSize ?? 0, values.contentModificationDate ?? .distantPast)
+        }.sorted { $0.date < $1.date }
+        
+        lock.lock()
+        defer { lock.unlock() }
+        for file in sorted {
+            evict(index.insert(file.url, forKey: file.url.lastPathComponent, cost: file.size))
+        }
+    }
+    
+    /// Must hold `lock`. Only the cache's names are removed; handed-out links keep their data.
+    private func evict(_ evicted: [(key: String, value: URL)]) {
+        guard !evicted.isEmpty else { return }
+        
+        evicted.forEach { try? fileManager.removeItem(at: $0.value) }
+        Logger.shared.debug("Evicted \(evicted.count) media cache files over budget")
+    }
+}
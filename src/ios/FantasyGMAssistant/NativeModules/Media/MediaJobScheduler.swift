@@ -0,0 +1,176 @@
+//
+// MediaJobScheduler.swift
+// FantasyGMAssistant
+//
+// Bounded scheduling and cancellable operation tracking for media jobs
+// Version: 1.0.0
+//
+
+import Foundation // iOS 14.0+
+
+// MARK: - Job Scheduler
+/// Runs at most `limit` jobs at once and queues the rest in arrival order. Waiting jobs hold no
+/// thread, and a job cancelled while still queued leaves the queue without ever running.
+final class MediaJobScheduler {
+    /// Shared by every MediaProcessor so encodes are bounded app-wide. The limit follows the
+    /// published performance profile.
+    static let encodes: MediaJobScheduler = {
+        let scheduler = MediaJobScheduler(limit: encodeLimit(for: PerformanceProfileMonitor.shared.current))
+        PerformanceProfileMonitor.shared.register(scheduler)
+        return scheduler
+    }()
+    
+    private struct Waiter {
+        let id: UUID
+        let continuation: CheckedContinuation<Void, Error>
+    }
+    
+    private let lock = NSLock()
+    private var currentLimit: Int
+    private var running = 0
+    private var waiters: [Waiter] = []
+    
+    init(limit: Int) {
+        self.currentLimit = max(1, limit)
+    }
+    
+    /// Hardware encoder sessions and memory both run out before cores do, so low-end devices
+    /// encode one clip at a time, and so does any device without thermal headroom or saving power
+    static func encodeLimit(for profile: PerformanceProfile) -> Int {
+        guard !profile.isConstrained else { return 1 }
+        
+        switch profile.deviceClass {
+        case .high: return 3
+        case .mid: return 2
+        case .low: return 1
+        }
+    }
+    
+    var limit: Int {
+        lock.lock()
+        defer { lock.unlock() }
+        return currentLimit
+    }
+    
+    /// Raising the limit starts queued jobs at once; lowering it lets running jobs finish
+    func setLimit(_ limit: Int) {
+        lock.lock()
+        currentLimit = max(1, limit)
+        var started: [Waiter] = []
+        while running < currentLimit, !waiters.isEmpty {
+            running += 1
+            started.append(waiters.removeFirst())
+        }
+        lock.unlock()
+        
+        started.forEach { $0.continuation.resume() }
+    }
+    
+    var queuedCount: Int {
+        lock.lock()
+        defer { lock.unlock() }
+        return waiters.count
+    }
+    
+    func run<T>(_ job: () async throws -> T) async throws -> T {
+        try await acquire()
+        defer { release() }
+        return try await job()
+    }
+    
+    // MARK: - Private Methods
+    private func acquire() async throws {
+        let id = UUID()
+        
+        try await withTaskCancellationHandler {
+            try await withCheckedThrowingContinuation { (continuation: CheckedContinuation<Void, Error>) in
+                lock.lock()
+                if Task.isCancelled {
+                    lock.unlock()
+                    continuation.resume(throwing: CancellationError())
+                } else if running < currentLimit {
+                    running += 1
+                    lock.unlock()
+                    continuation.resume()
+                } else {
+                    waiters.append(Waiter(id: id, continuation: continuation))
+                    lock.unlock()
+                }
+            }
+        } onCancel: {
+            lock.lock()
+            let index = waiters.firstIndex { $0.id == id }
+            let waiter = index.map { waiters.remove(at: $0) }
+            lock.unlock()
+            
+            waiter?.continuation.resume(throwing: CancellationError())
+        }
+    }
+    
+    private func release() {
+        lock.lock()
+        // Over the limit after it was lowered, so the slot is given up rather than passed on
+        guard !waiters.isEmpty, running <= currentLimit else {
+            running -= 1
+            lock.unlock()
+            return
+        }
+        
+        // The slot passes straight to the next job, so `running` is unchanged
+        let next = waiters.removeFirst()
+        lock.unlock()
+        next.continuation.resume()
+    }
+}
+
+// MARK: - Performance Profile
+extension MediaJobScheduler: PerformanceProfileObserver {
+    func performanceProfileDidChange(_ profile: PerformanceProfile) {
+        setLimit(MediaJobScheduler.encodeLimit(for: profile))
+    }
+}
+
+// MARK: - Operation Registry
+/// Maps bridge operation IDs to running work so they can be cancelled from JavaScript.
+/// Cancellation reaches every child task, including in-flight FFmpeg sessions.
+final class MediaOperationRegistry {
+    private let lock = NSLock()
+    private var cancellers: [String: () -> Void] = [:]
+    
+    var activeCount: Int {
+        lock.lock()
+        defer { lock.unlock() }
+        return cancellers.count
+    }
+    
+    func run<T>(_ operationID: String, _ work: @escaping () async -> T) async -> T {
+        let task = Task { await work() }
+        lock.lock()
+        cancellers[operationID] = { task.cancel() }
+        lock.unlock()
+        
+        defer {
+            lock.lock()
+            cancellers.removeValue(forKey: operationID)
+            lock.unlock()
+        }
+        
+        // `task` is unstructured, so cancelling the caller has to be forwarded explicitly
+        return await withTaskCancellationHandler {
+            await task.value
+        } onCancel: {
+            task.cancel()
+        }
+    }
+    
+    /// Returns false when no operation with that ID is running
+    @discardableResult
+    func cancel(_ operationID: String) -> Bool {
+        lock.lock()
+        let canceller = cancellers[operationID]
+        lock.unlock()
+        
+        canceller?()
+        return canceller != nil
+    }
+}
@@ -0,0 +1,79 @@
+//
+// MediaPipelineProgress.swift
+// FantasyGMAssistant
+//
+// Stage-weighted progress for the trade analysis video pipeline
+// Version: 1.0.0
+//
+
+import Foundation // iOS 14.0+
+
+// MARK: - Pipeline Stages
+public enum MediaPipelineStage: Int, CaseIterable {
+    case script
+    case visuals
+    case voiceover
+    case mux
+    case encode
+    
+    /// Share of overall progress; weights sum to 1. Visuals and voiceover run at the same time,
+    /// so both advance the total independently.
+    var weight: Double {
+        switch self {
+        case .script: return 0.1
+        case .visuals: return 0.35
+        case .voiceover: return 0.2
+        case .mux: return 0.05
+        case .encode: return 0.3
+        }
+    }
+}
+
+// MARK: - Pipeline Progress
+/// Combines per-stage fractions reported from concurrent stages into one overall value for a
+/// `ProgressHandler`. Reported values only increase, and exactly 1.0 is reported once every
+/// stage has completed.
+final class MediaPipelineProgress {
+    private let lock = NSLock()
+    private let handler: ProgressHandler?
+    private var fractions: [MediaPipelineStage: Double] = [:]
+    private var reported: Double = 0
+    
+    init(handler: ProgressHandler?) {
+        self.handler = handler
+    }
+    
+    func update(_ stage: MediaPipelineStage, fraction: Double) {
+        lock.lock()
+        defer { lock.unlock() }
+        
+        fractions[stage] = max(fractions[stage] ?? 0, min(max(fraction, 0), 1))
+        report()
+    }
+    
+    /// Adds to a stage made of independent units, such as visual segments finishing out of order
+    func advance(_ stage: MediaPipelineStage, by delta: Double) {
+        lock.lock()
+        defer { lock.unlock() }
+        
+        fractions[stage] = min((fractions[stage] ?? 0) + delta, 1)
+        report()
+    }
+    
+    func complete(_ stage: MediaPipelineStage) {
+        update(stage, fraction: 1)
+    }
+    
+    // MARK: - Private Methods
+    /// Must hold `lock`; the handler is called under it so concurrent stages cannot reorder reports
+    private func report() {
+        let finished = MediaPipelineStage.allCases.allSatisfy { fractions[$0] == 1 }
+        let overall = finished ? 1 : MediaPipelineStage.allCases.reduce(0) { total, stage in
+            total + stage.weight * (fractions[stage] ?? 0)
+        }
+        
+        guard overall > reported else { return }
+        reported = min(overall, 1)
+        handler?(reported)
+    }
+}
@@ -0,0 +1,113 @@
+//
+// MediaProcessor+Encoding.swift
+// FantasyGMAssistant
+//
+// FFmpeg encode and mux steps for MediaProcessor, run as cancellable async sessions
+// Version: 1.0.0
+//
+
+import Foundation // iOS 14.0+
+import AVFoundation // iOS 14.0+
+
+@available(iOS 14.0, *)
+extension MediaProcessor {
+    // MARK: - Encoding
+    /// Re-encodes `fileURL` once a slot in the app-wide encode scheduler is free. Progress follows
+    /// FFmpeg's output position against the expected duration.
+    func encode(_ fileURL: URL,
+                options: MediaProcessingOptions,
+                progressHandler: ProgressHandler?) async throws -> URL {
+        let outputURL = TemporaryFileRegistry.shared.makeURL(pathExtension: options.format)
+        
+        let sourceDuration = AVURLAsset(url: fileURL).duration.seconds
+        let duration = sourceDuration.isFinite && sourceDuration > 0
+            ? min(sourceDuration, options.maxDuration)
+            : options.maxDuration
+        let settings = VideoEncodeSettings.select(for: options, duration: duration)
+        
+        do {
+            try await MediaJobScheduler.encodes.run {
+                do {
+                    try await runEncode(fileURL, to: outputURL, options: options, settings: settings,
+                                        duration: duration, progressHandler: progressHandler)
+                } catch is MediaError where settings.encoder.isHardware {
+                    // Hardware sessions fail when the encoder is unavailable, e.g. while backgrounded
+                    Logger.shared.debug("\(settings.encoder.codecName) encode failed, retrying with libx264")
+                    try? FileManager.default.removeItem(at: outputURL)
+                    
+                    let fallback = VideoEncodeSettings.software(for: options, duration: duration)
+                    try await runEncode(fileURL, to: outputURL, options: options, settings: fallback,
+                                        duration: duration, progressHandler: progressHandler)
+                }
+            }
+            return outputURL
+        } catch {
+            try? FileManager.default.removeItem(at: outputURL)
+            throw error
+        }
+    }
+    
+    /// Joins the segments in order under the narration. Video is stream-copied, so only the
+    /// audio is re-encoded here; the full re-encode happens once in `processMediaFile`.
+    func muxVideo(segments: [URL], audioURL: URL) async throws -> URL {
+        let outputURL = TemporaryFileRegistry.shared.makeURL(pathExtension: "mp4")
+        let listURL = try writeConcatList(segments)
+        defer { try? FileManager.default.removeItem(at: listURL) }
+        
+        let command = "-f concat -safe 0 -i \(listURL.path) -i \(audioURL.path) " +
+            "-map 0:v -map 1:a -c:v copy -c:a aac -shortest \(outputURL.path)"
+        try await FFmpegAsyncSession.execute(command)
+        return outputURL
+    }
+    
+    /// Joins voiceover chunks in order. They share one codec and bitrate, so the streams are
+    /// copied rather than decoded and re-encoded.
+    func concatenateAudio(_ chunks: [URL]) async throws -> URL {
+        let outputURL = TemporaryFileRegistry.shared.makeURL(pathExtension: "mp3")
+        let listURL = try writeConcatList(chunks)
+        defer { try? FileManager.default.removeItem(at: listURL) }
+        
+        do {
+            try await FFmpegAsyncSession.execute("-f concat -safe 0 -i \(listURL.path) -c copy \(outputURL.path)")
+            return outputURL
+        } catch {
+            try? FileManager.default.removeItem(at: outputURL)
+            throw error
+        }
+    }
+    
+    // MARK: - Private Methods
+    /// Input list for FFmpeg's concat demuxer; the caller removes it
+    private func writeConcatList(_ files: [URL]) throws -> URL {
+        let listURL = TemporaryFileRegistry.shared.makeURL(pathExtension: "txt")
+        let list = files.map { "file '\($0.path)'" }.joined(separator: "\n")
+        try list.write(to: listURL, atomically: true, encoding: .utf8)
+        return listURL
+    }
+    
+    private func runEncode(_ input: URL,
+                           to output: URL,
+                           options: MediaProcessingOptions,
+                           settings: VideoEncodeSettings,
+                           duration: TimeInterval,
+                           progressHandler: ProgressHandler?) async throws {
+        let command = generateFFmpegCommand(input: input, output: output, options: options, settings: settings)
+        try await FFmpegAsyncSession.execute(command) { statistics in
+            progressHandler?(statistics.fraction(of: duration))
+        }
+    }
+    
+    private func generateFFmpegCommand(input: URL,
+                                       output: URL,
+                                       options: MediaProcessingOptions,
+                                       settings: VideoEncodeSettings) -> String {
+        var command = "-i \(input.path) "
+        command += settings.ffmpegArguments
+        command += VideoEncodeSettings.audioArguments
+        // Bounds the output so the bitrate budget computed for `maxDuration` holds
+        command += "-t \(Int(options.maxDuration)) "
+        command += "\(output.path)"
+        
+        return command
+    }
+}
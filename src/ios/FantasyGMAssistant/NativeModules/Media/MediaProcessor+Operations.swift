@@ -0,0 +1,70 @@
+//
+// MediaProcessor+Operations.swift
+// FantasyGMAssistant
+//
+// Bridge-facing entry points and cancellation for MediaProcessor operations
+// Version: 1.0.0
+//
+
+import Foundation // iOS 14.0+
+
+@available(iOS 14.0, *)
+extension MediaProcessor {
+    // MARK: - Bridge Operations
+    /// Bridge entry point; the bridge's operation ID is what `cancelOperation` takes
+    @objc public func generateTradeAnalysisVideo(tradeDetails: [String: Any],
+                                               operationID: String,
+                                               progressHandler: ProgressHandler?,
+                                               completionHandler: @escaping (URL?, Error?) -> Void) {
+        Task {
+            let result = await generateTradeAnalysisVideo(tradeDetails: tradeDetails,
+                                                          operationID: operationID,
+                                                          progressHandler: progressHandler)
+            switch result {
+            case .success(let videoURL):
+                completionHandler(videoURL, nil)
+            case .failure(let error):
+                completionHandler(nil, error)
+            }
+        }
+    }
+    
+    /// Bridge entry point for `processMediaFile`; `options` is the JS options dictionary
+    @objc public func processMediaFile(fileURL: URL,
+                                       options: [String: Any],
+                                       operationID: String,
+                                       progressHandler: ProgressHandler?,
+                                       completionHandler: @escaping (URL?, Error?) -> Void) {
+        Task {
+            let result = await processMediaFile(fileURL: fileURL,
+                                                options: MediaProcessingOptions(dictionary: options),
+                                                operationID: operationID,
+                                                progressHandler: progressHandler)
+            switch result {
+            case .success(let outputURL):
+                completionHandler(outputURL, nil)
+            case .failure(let error):
+                completionHandler(nil, error)
+            }
+        }
+    }
+    
+    // MARK: - Cancellation
+    /// Cancels the operation and every encode it started. Returns false when it is not running.
+    @objc @discardableResult
+    public func cancelOperation(_ operationID: String) -> Bool {
+        return operations.cancel(operationID)
+    }
+}
+
+// MARK: - Bridge Options
+extension MediaProcessingOptions {
+    /// Keys as sent from JS; anything missing falls back to the trade video's own settings
+    init(dictionary: [String: Any]) {
+        self.init(quality: dictionary["quality"] as? String ?? "high",
+                  format: dictionary["format"] as? String ?? "mp4",
+                  optimization: dictionary["optimization"] as? String ?? "quality",
+                  maxDuration: (dictionary["max_duration"] as? NSNumber)?.doubleValue ?? 180,
+                  maxFileSize: (dictionary["max_file_size"] as? NSNumber)?.int64Value ?? 50_000_000)
+    }
+}
@@ -0,0 +1,120 @@
+//
+// MediaProcessor+Voiceover.swift
+// FantasyGMAssistant
+//
+// Chunked, streamed voiceover synthesis for MediaProcessor
+// Version: 1.0.0
+//
+
+import Foundation // iOS 14.0+
+
+// MARK: - Voiceover Constants
+/// Concurrent synthesis requests per voiceover; more only queues at the provider
+private let MAX_CONCURRENT_VOICE_CHUNKS = 3
+
+@available(iOS 14.0, *)
+extension MediaProcessor {
+    // MARK: - Voiceover
+    /// Scripts of any length are split at sentence boundaries, synthesized a few chunks at a time
+    /// and joined without a re-encode. Identical text, quality and voice are synthesized once;
+    /// later calls get a link to the cached file, held by the calling operation, that shares the
+    /// cached data and must not be modified in place.
+    public func generateVoiceOver(text: String,
+                                quality: VoiceQuality,
+                                voiceID: String = MediaProcessor.defaultVoiceID) async -> Result<URL, MediaError> {
+        let chunks = VoiceoverScript.chunks(of: text)
+        guard !chunks.isEmpty else {
+            return .failure(.invalidInput)
+        }
+        
+        let cacheKey = MediaCache.voiceoverKey(text: text, quality: quality, voiceID: voiceID)
+        if let cachedURL = mediaCache?.url(forKey: cacheKey, fileExtension: "mp3") {
+            return .success(cachedURL)
+        }
+        
+        do {
+            let audioURL = try await withOperationFiles { () async throws -> URL in
+                let detail = "\(chunks.count) chunks"
+                let chunkURLs = try await PerformanceTracer.shared.trace("media_voiceover", detail: detail) {
+                    try await synthesizeChunks(chunks, quality: quality, voiceID: voiceID)
+                }
+                // A single chunk is already cached under its own text
+                guard chunkURLs.count > 1 else {
+                    return chunkURLs[0]
+                }
+                
+                let joinedURL = try await concatenateAudio(chunkURLs)
+                return mediaCache?.store(joinedURL, forKey: cacheKey) ?? joinedURL
+            }
+            return .success(audioURL)
+        } catch is CancellationError {
+            return .failure(.cancelled)
+        } catch let error as MediaError {
+            return .failure(error)
+        } catch {
+            return .failure(.networkError)
+        }
+    }
+    
+    // MARK: - Private Methods
+    /// Synthesizes at most `MAX_CONCURRENT_VOICE_CHUNKS` chunks at once and returns them in script order.
+    /// Chunks are cached individually, so boilerplate shared between scripts is synthesized once.
+    private func synthesizeChunks(_ chunks: [String], quality: VoiceQuality, voiceID: String) async throws -> [URL] {
+        return try await withThrowingTaskGroup(of: (Int, URL).self) { group -> [URL] in
+            var urls = [URL?](repeating: nil, count: chunks.count)
+            for (index, chunk) in chunks.enumerated() {
+                if index >= MAX_CONCURRENT_VOICE_CHUNKS, let finished = try await group.next() {
+                    urls[finished.0] = finished.1
+                }
+                group.addTask {
+                    let key = MediaCache.voiceoverKey(text: chunk, quality: quality, voiceID: voiceID)
+                    let produce: () async throws -> URL = {
+                        try await self.retryManager.execute {
+                            try await self.downloadVoiceOver(text: chunk, quality: quality, voiceID: voiceID)
+                        }
+                    }
+                    guard let cache = self.mediaCache else { return (index, try await produce()) }
+                    return (index, try await cache.cachedOrProduce(key, fileExtension: "mp3", produce: produce))
+                }
+            }
+            
+            for try await (finished, url) in group {
+                urls[finished] = url
+            }
+            return urls.compactMap { $0 }
+        }
+    }
+    
+    /// Streams the response straight to a file instead of buffering the audio in memory
+    private func downloadVoiceOver(text: String, quality: VoiceQuality, voiceID: String) async throws -> URL {
+        guard let endpoint = URL(string: Constants.APIEndpoints.media.voiceover) else {
+            throw MediaError.invalidInput
+        }
+        
+        var request = URLRequest(url: endpoint)
+        request.httpMethod = "POST"
+        request.setValue("application/json", forHTTPHeaderField: "Content-Type")
+        // Read without blocking; FirebaseAuthManager refreshes the token ahead of expiry
+        if let token = AuthTokenStore.shared.token() {
+            request.setValue("Bearer \(token)", forHTTPHeaderField: "Authorization")
+        }
+        request.httpBody = try JSONSerialization.data(withJSONObject: [
+            "text": text,
+            "quality": quality.rawValue,
+            "voice_id": voiceID,
+            "api_key": ELEVEN_LABS_API_KEY
+        ])
+        
+        let (downloadURL, response) = try await URLSession.shared.download(for: request)
+        guard let httpResponse = response as? HTTPURLResponse,
+              httpResponse.statusCode == 200 else {
+            try? FileManager.default.removeItem(at: downloadURL)
+            throw MediaError.apiError("Voice generation failed")
+        }
+        
+        // The downloaded file is deleted once this call returns, so it is moved out first
+        let outputURL = TemporaryFileRegistry.shared.makeURL(pathExtension: "mp3")
+        try FileManager.default.moveItem(at: downloadURL, to: outputURL)
+        return outputURL
+    }
+}
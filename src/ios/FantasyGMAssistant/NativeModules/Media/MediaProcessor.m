@@ -40,11 +40,8 @@ RCT_EXPORT_MODULE(MediaProcessorBridge)
         // Initialize active operations tracking
         self.activeOperations = [NSMutableDictionary dictionary];
         
-        // Register for memory warnings
-        [[NSNotificationCenter defaultCenter] addObserver:self
-                                               selector:@selector(handleMemoryWarning)
-                                                   name:UIApplicationDidReceiveMemoryWarningNotification
-                                                 object:nil];
+        // Memory warnings are handled by MemoryPressureCoordinator, which trims the media cache
+        // without cancelling operations the user is waiting on
     }
     return self;
 }
@@ -62,15 +59,16 @@ RCT_EXPORT_METHOD(generateTradeAnalysisVideo:(NSDictionary *)tradeDetails
                   resolver:(RCTPromiseResolveBlock)resolve
                   rejecter:(RCTPromiseRejectBlock)reject) {
     
-    NSString *operationId = [[NSUUID UUID] UUIDString];
-    self.activeOperations[operationId] = @YES;
-    
     // Validate input parameters
     if (!tradeDetails || ![tradeDetails isKindOfClass:[NSDictionary class]]) {
         reject(@"invalid_input", @"Invalid trade details provided", nil);
         return;
     }
     
+    // Callers that want to cancel pass their own ID and hand it to cancelOperation later
+    NSString *operationId = tradeDetails[@"operation_id"] ?: [[NSUUID UUID] UUIDString];
+    self.activeOperations[operationId] = @YES;
+    
     // Create progress handler
     void (^progressHandler)(double) = ^(double progress) {
         if (progressCallback) {
@@ -80,7 +78,8 @@ RCT_EXPORT_METHOD(generateTradeAnalysisVideo:(NSDictionary *)tradeDetails
     
     // Execute on processing queue
     dispatch_async(self.processingQueue, ^{
-        [self.mediaProcessor generateTradeAnalysisVideoWithTradeDetails:tradeDetails 
+        [self.mediaProcessor generateTradeAnalysisVideoWithTradeDetails:tradeDetails
+                                                            operationID:operationId
                                                       progressHandler:progressHandler
                                                        completionHandler:^(NSURL * _Nullable videoURL, NSError * _Nullable error) {
             // Remove operation tracking
@@ -154,8 +153,9 @@ RCT_EXPORT_METHOD(processMediaFile:(NSString *)fileURLString
         return;
     }
     
-    // Create processing options
-    MediaProcessingOptions *processingOptions = [[MediaProcessingOptions alloc] initWithDictionary:options];
+    // Same contract as generateTradeAnalysisVideo: an "operation_id" option makes the encode cancellable
+    NSString *operationId = options[@"operation_id"] ?: [[NSUUID UUID] UUIDString];
+    self.activeOperations[operationId] = @YES;
     
     // Create progress handler
     void (^progressHandler)(double) = ^(double progress) {
@@ -167,9 +167,12 @@ RCT_EXPORT_METHOD(processMediaFile:(NSString *)fileURLString
     // Execute processing
     dispatch_async(self.processingQueue, ^{
         [self.mediaProcessor processMediaFileWithFileURL:fileURL
-                                              options:processingOptions
-                                      progressHandler:progressHandler
-                                   completionHandler:^(NSURL * _Nullable outputURL, NSError * _Nullable error) {
+                                                 options:options ?: @{}
+                                             operationID:operationId
+                                         progressHandler:progressHandler
+                                       completionHandler:^(NSURL * _Nullable outputURL, NSError * _Nullable error) {
+            [self.activeOperations removeObjectForKey:operationId];
+            
             if (error) {
                 reject(@"processing_failed",
                       error.localizedDescription,
@@ -186,24 +189,9 @@ RCT_EXPORT_METHOD(cancelOperation:(NSString *)operationId
                   resolver:(RCTPromiseResolveBlock)resolve
                   rejecter:(RCTPromiseRejectBlock)reject) {
     
-    if ([self.activeOperations objectForKey:operationId]) {
-        [self.mediaProcessor cancelCurrentTask];
-        [self.activeOperations removeObjectForKey:operationId];
-        resolve(@YES);
-    } else {
-        resolve(@NO);
-    }
-}
-
-- (void)handleMemoryWarning {
-    // Cancel non-critical operations
-    [self.mediaProcessor cancelCurrentTask];
-    
-    // Clear active operations
-    [self.activeOperations removeAllObjects];
-    
-    // Clean up temporary files
-    [self.mediaProcessor cleanupTemporaryFiles];
+    BOOL cancelled = [self.mediaProcessor cancelOperation:operationId];
+    [self.activeOperations removeObjectForKey:operationId];
+    resolve(@(cancelled));
 }
 
 - (void)dealloc {
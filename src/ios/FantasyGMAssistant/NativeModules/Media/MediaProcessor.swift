@@ -10,6 +10,11 @@ import Foundation // iOS 14.0+
 import AVFoundation // iOS 14.0+
 import FFmpegKit // v5.1
 
+// MARK: - Pipeline Constants
+// Segments encode on their own threads, so more than one per core only adds contention
+private let MAX_CONCURRENT_SEGMENTS = max(2, ProcessInfo.processInfo.activeProcessorCount)
+private let PLAYER_INTRO_TEMPLATE = "player_intro"
+
 // MARK: - Error Types
 public enum MediaError: Error {
     case invalidInput
@@ -20,6 +25,7 @@ public enum MediaError: Error {
     case cacheError
     case networkError
     case optimizationFailed
+    case cancelled
 }
 
 // MARK: - Type Definitions
@@ -31,6 +37,12 @@ public enum VoiceQuality {
     case premium
 }
 
+/// Results of the concurrent stages of the trade analysis pipeline
+private enum PipelineOutput {
+    case voiceover(URL)
+    case segment(Int, URL)
+}
+
 public struct MediaProcessingOptions {
     let quality: String
     let format: String
@@ -64,7 +76,7 @@ private class ResourceMonitor {
 }
 
 // MARK: - Retry Manager
-private class RetryManager {
+final class RetryManager {
     private let maxAttempts: Int = MAX_RETRY_ATTEMPTS
     
     func execute<T>(_ operation: @escaping () async throws -> T) async throws -> T {
@@ -90,8 +102,14 @@ private class RetryManager {
 @objc public class MediaProcessor: NSObject {
     private let ffmpegKit: FFmpegKit
     private let cache: URLCache
-    private let retryManager: RetryManager
+    let retryManager: RetryManager
     private let resourceMonitor: ResourceMonitor
+    /// ElevenLabs voice used when callers do not pick one
+    public static let defaultVoiceID = "21m00Tcm4TlvDq8ikWAM"
+    /// Reuses voiceovers and segments produced from identical inputs; nil if the directory is unusable
+    let mediaCache = MediaCache.shared
+    /// Running bridge operations by ID, so `cancelOperation` reaches the work itself
+    let operations = MediaOperationRegistry()
     
     public init(config: MediaConfig? = nil) {
         self.ffmpegKit = FFmpegKit()
@@ -102,15 +120,28 @@ private class RetryManager {
         self.resourceMonitor = ResourceMonitor.shared
         super.init()
         
-        NotificationCenter.default.addObserver(self,
-                                             selector: #selector(handleMemoryWarning),
-                                             name: UIApplication.didReceiveMemoryWarningNotification,
-                                             object: nil)
+        // Media responses are large and re-fetchable, so they are trimmed first
+        MemoryPressureCoordinator.shared.register(self, name: "MediaProcessor", priority: .low)
     }
     
     // MARK: - Public Methods
+    /// Cancellable through `cancelOperation(_:)` with `operationID` until it returns
     public func generateTradeAnalysisVideo(tradeDetails: [String: Any],
+                                         operationID: String = UUID().uuidString,
                                          progressHandler: ProgressHandler? = nil) async -> Result<URL, MediaError> {
+        // Renders are sampled densely by PerformanceOptimizer
+        PerformanceActivity.shared.begin(.videoRender)
+        defer { PerformanceActivity.shared.end(.videoRender) }
+        
+        return await operations.run(operationID) {
+            await PerformanceTracer.shared.trace("generate_trade_video") {
+                await self.runTradeAnalysisPipeline(tradeDetails, progressHandler: progressHandler)
+            }
+        }
+    }
+    
+    private func runTradeAnalysisPipeline(_ tradeDetails: [String: Any],
+                                          progressHandler: ProgressHandler?) async -> Result<URL, MediaError> {
         guard resourceMonitor.checkResources() else {
             return .failure(.resourceUnavailable)
         }
@@ -122,103 +153,73 @@ private class RetryManager {
                 return .failure(.invalidInput)
             }
             
-            progressHandler?(0.1)
+            let progress = MediaPipelineProgress(handler: progressHandler)
             
-            // Generate script
-            let script = try await generateVideoScript(tradeDetails)
-            progressHandler?(0.2)
+            let tracer = PerformanceTracer.shared
             
-            // Generate voiceover
-            let voiceoverResult = await generateVoiceOver(text: script, quality: .premium)
-            guard case .success(let audioURL) = voiceoverResult else {
-                return .failure(.processingFailed)
+            // Narration, segments and the mux are deleted when the pipeline ends; only the encode is kept
+            let outputURL = try await withOperationFiles { () async throws -> URL in
+                // Generate script
+                let script = try await tracer.trace("media_script") { try await generateVideoScript(tradeDetails) }
+                progress.complete(.script)
+                
+                // Visuals do not depend on the narration, so both render at once and only join to mux
+                let (segmentURLs, audioURL) = try await tracer.trace("media_render") {
+                    try await renderVisualsAndVoiceover(players: playersInvolved, script: script, progress: progress)
+                }
+                
+                let videoURL = try await tracer.trace("media_mux") {
+                    try await muxVideo(segments: segmentURLs, audioURL: audioURL)
+                }
+                progress.complete(.mux)
+                
+                // Process final video
+                let options = MediaProcessingOptions(quality: "high",
+                                                     format: "mp4",
+                                                     optimization: "quality",
+                                                     maxDuration: 180,
+                                                     maxFileSize: 50_000_000)
+                
+                let outputURL = try await tracer.trace("media_encode") {
+                    try await encode(videoURL, options: options) { fraction in
+                        progress.update(.encode, fraction: fraction)
+                    }
+                }
+                progress.complete(.encode)
+                return outputURL
             }
-            progressHandler?(0.4)
-            
-            // Generate video content
-            let videoURL = try await generateVideoContent(tradeDetails, audioURL)
-            progressHandler?(0.7)
-            
-            // Process final video
-            let options = MediaProcessingOptions(quality: "high",
-                                               format: "mp4",
-                                               optimization: "quality",
-                                               maxDuration: 180,
-                                               maxFileSize: 50_000_000)
-            
-            let result = await processMediaFile(fileURL: videoURL,
-                                              options: options,
-                                              progressHandler: { progress in
-                progressHandler?(0.7 + (progress * 0.3))
-            })
-            
-            cleanupTemporaryFiles()
-            return result
+            return .success(outputURL)
             
+        } catch is CancellationError {
+            return .failure(.cancelled)
         } catch {
-            cleanupTemporaryFiles()
             return .failure(.processingFailed)
         }
     }
     
-    public func generateVoiceOver(text: String,
-                                quality: VoiceQuality) async -> Result<URL, MediaError> {
-        guard !text.isEmpty, text.count <= 5000 else {
-            return .failure(.invalidInput)
-        }
-        
-        return await retryManager.execute {
-            let endpoint = Constants.APIEndpoints.media.voiceover
-            let parameters: [String: Any] = [
-                "text": text,
-                "quality": quality.rawValue,
-                "api_key": ELEVEN_LABS_API_KEY
-            ]
-            
-            // API call implementation
-            let (data, response) = try await URLSession.shared.upload(
-                for: URLRequest(url: URL(string: endpoint)!),
-                from: try JSONSerialization.data(withJSONObject: parameters)
-            )
-            
-            guard let httpResponse = response as? HTTPURLResponse,
-                  httpResponse.statusCode == 200 else {
-                throw MediaError.apiError("Voice generation failed")
-            }
-            
-            let outputURL = FileManager.default.temporaryDirectory
-                .appendingPathComponent(UUID().uuidString)
-                .appendingPathExtension("mp3")
-            
-            try data.write(to: outputURL)
-            return .success(outputURL)
-        } ?? .failure(.processingFailed)
-    }
-    
+    /// Queued behind other encodes when the device's concurrent encode limit is reached
     public func processMediaFile(fileURL: URL,
                                options: MediaProcessingOptions,
+                               operationID: String = UUID().uuidString,
                                progressHandler: ProgressHandler? = nil) async -> Result<URL, MediaError> {
         guard FileManager.default.fileExists(atPath: fileURL.path) else {
             return .failure(.invalidInput)
         }
         
-        do {
-            let outputURL = FileManager.default.temporaryDirectory
-                .appendingPathComponent(UUID().uuidString)
-                .appendingPathExtension(options.format)
-            
-            let command = generateFFmpegCommand(input: fileURL,
-                                              output: outputURL,
-                                              options: options)
-            
-            let session = FFmpegKit.execute(command)
-            guard session?.getReturnCode().isValueSuccess() ?? false else {
-                throw MediaError.processingFailed
+        return await operations.run(operationID) {
+            do {
+                let outputURL = try await self.withOperationFiles { () async throws -> URL in
+                    // The input may be another operation's output; holding it stops it being deleted mid-encode
+                    TemporaryFileScope.current?.retain(fileURL)
+                    return try await self.encode(fileURL, options: options, progressHandler: progressHandler)
+                }
+                progressHandler?(1.0)
+                return .success(outputURL)
+            } catch is CancellationError {
+                return .failure(.cancelled)
+            } catch {
+                return .failure(.processingFailed)
             }
-            
-            return .success(outputURL)
-        } catch {
-            return .failure(.processingFailed)
         }
     }
     
@@ -228,51 +229,105 @@ private class RetryManager {
         return ""
     }
     
-    private func generateVideoContent(_ tradeDetails: [String: Any], _ audioURL: URL) async throws -> URL {
-        // Implementation of video content generation logic
-        return URL(fileURLWithPath: "")
-    }
-    
-    private func generateFFmpegCommand(input: URL, output: URL, options: MediaProcessingOptions) -> String {
-        var command = "-i \(input.path) "
-        
-        switch options.quality {
-        case "high":
-            command += "-c:v libx264 -preset slow -crf 22 "
-        case "medium":
-            command += "-c:v libx264 -preset medium -crf 23 "
-        default:
-            command += "-c:v libx264 -preset fast -crf 24 "
+    /// Runs the voiceover and every visual segment as child tasks of one group, with at most
+    /// `MAX_CONCURRENT_SEGMENTS` rendering at a time, halved below the full performance level.
+    /// A failure in any stage cancels the rest.
+    private func renderVisualsAndVoiceover(players: [[String: Any]],
+                                           script: String,
+                                           progress: MediaPipelineProgress) async throws -> ([URL], URL) {
+        let outputs = try await withThrowingTaskGroup(of: PipelineOutput.self) { group -> [PipelineOutput] in
+            group.addTask {
+                let audioURL = try await self.generateVoiceOver(text: script, quality: .premium).get()
+                progress.complete(.voiceover)
+                return .voiceover(audioURL)
+            }
+            
+            let level = PerformanceProfileMonitor.shared.current.level
+            let window = level == .full ? MAX_CONCURRENT_SEGMENTS : max(1, MAX_CONCURRENT_SEGMENTS / 2)
+            var outputs: [PipelineOutput] = []
+            var renderingSegments = 0
+            for (index, player) in players.enumerated() {
+                // Only segment completions free a slot; the voiceover finishing must not let one more in
+                while renderingSegments >= window, let output = try await group.next() {
+                    outputs.append(output)
+                    if case .segment = output {
+                        renderingSegments -= 1
+                    }
+                }
+                renderingSegments += 1
+                group.addTask {
+                    let segmentURL = try await self.renderSegment(PLAYER_INTRO_TEMPLATE, parameters: player)
+                    progress.advance(.visuals, by: 1 / Double(players.count))
+                    return .segment(index, segmentURL)
+                }
+            }
+            
+            for try await output in group {
+                outputs.append(output)
+            }
+            return outputs
         }
+        // Per-segment advances can fall short of the full stage through rounding, or with no players
+        progress.complete(.visuals)
         
-        command += "-c:a aac -b:a 128k "
-        command += "\(output.path)"
+        var segmentURLs = [URL?](repeating: nil, count: players.count)
+        var audioURL: URL?
+        for output in outputs {
+            switch output {
+            case .voiceover(let url):
+                audioURL = url
+            case .segment(let index, let url):
+                segmentURLs[index] = url
+            }
+        }
         
-        return command
+        guard let narration = audioURL else {
+            throw MediaError.processingFailed
+        }
+        return (segmentURLs.compactMap { $0 }, narration)
     }
     
-    private func cleanupTemporaryFiles() {
-        let fileManager = FileManager.default
-        let tmpDirectory = fileManager.temporaryDirectory
+    /// Segments depend only on their template and parameters, so repeated player intros are
+    /// rendered once and then served from the media cache
+    private func renderSegment(_ template: String, parameters: [String: Any]) async throws -> URL {
+        guard let cache = mediaCache else {
+            return try await renderVisualSegment(template, parameters: parameters)
+        }
         
-        do {
-            let tmpContents = try fileManager.contentsOfDirectory(at: tmpDirectory,
-                                                                includingPropertiesForKeys: nil,
-                                                                options: [])
-            for file in tmpContents where file.pathExtension == "mp4" || file.pathExtension == "mp3" {
-                try? fileManager.removeItem(at: file)
-            }
-        } catch {
-            print("Cleanup error: \(error)")
+        let key = MediaCache.segmentKey(template: template, parameters: parameters)
+        return try await cache.cachedOrProduce(key, fileExtension: "mp4") {
+            try await renderVisualSegment(template, parameters: parameters)
         }
     }
     
-    @objc private func handleMemoryWarning() {
-        cache.removeAllCachedResponses()
-        cleanupTemporaryFiles()
+    private func renderVisualSegment(_ template: String, parameters: [String: Any]) async throws -> URL {
+        // Implementation of visual segment rendering logic
+        return URL(fileURLWithPath: "")
+    }
+    
+    // MARK: - Temporary Files
+    /// Runs `work` in its own temporary file scope, so the intermediate files it makes are deleted
+    /// when it finishes. The file it returns is handed to the enclosing operation, or to the caller.
+    func withOperationFiles(_ work: () async throws -> URL) async throws -> URL {
+        let scope = TemporaryFileRegistry.shared.makeScope()
+        defer { scope.close() }
+        
+        let url = try await TemporaryFileScope.$current.withValue(scope) { try await work() }
+        TemporaryFileScope.current?.retain(url)
+        scope.keep(url)
+        return url
     }
     
     deinit {
         NotificationCenter.default.removeObserver(self)
     }
-}
\ No newline at end of file
+}
+
+// MARK: - Memory Pressure
+@available(iOS 14.0, *)
+extension MediaProcessor: MemoryPressureParticipant {
+    public func trimMemory(fraction: Double, level: MemoryPressureLevel) {
+        // Temporary renders are on disk and are deleted by the operations that own them
+        cache.trimMemory(fraction: fraction)
+    }
+}
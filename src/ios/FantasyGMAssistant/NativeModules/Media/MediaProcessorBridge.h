@@ -20,7 +20,8 @@ NS_ASSUME_NONNULL_BEGIN
 
 /**
  * Generates a trade analysis video with AI-powered content and voice narration.
- * @param tradeDetails Dictionary containing trade information and player details
+ * @param tradeDetails Dictionary containing trade information and player details; an optional
+ *        "operation_id" entry names the operation for a later cancelOperation call
  * @param resolve Promise resolution callback with video URL
  * @param reject Promise rejection callback with error details
  */
@@ -41,7 +42,8 @@ RCT_EXTERN_METHOD(generateVoiceOver:(nonnull NSString *)text
 /**
  * Processes media files with configurable options for optimization.
  * @param fileURL URL of the media file to process
- * @param options Dictionary of processing options (nullable)
+ * @param options Dictionary of processing options (nullable); an optional "operation_id" entry
+ *        names the operation for a later cancelOperation call
  * @param resolve Promise resolution callback with processed file URL
  * @param reject Promise rejection callback with error details
  */
@@ -68,7 +70,8 @@ typedef NS_ENUM(NSInteger, MediaProcessorErrorCode) {
     MediaProcessorErrorMemoryWarning = 1004,
     MediaProcessorErrorCacheError = 1005,
     MediaProcessorErrorNetworkError = 1006,
-    MediaProcessorErrorOptimizationFailed = 1007
+    MediaProcessorErrorOptimizationFailed = 1007,
+    MediaProcessorErrorCancelled = 1008
 };
 
 NS_ASSUME_NONNULL_END
\ No newline at end of file
@@ -0,0 +1,167 @@
+//
+// TemporaryFileRegistry.swift
+// FantasyGMAssistant
+//
+// Reference-counted temporary files owned by the operations that create and read them
+// Version: 1.0.0
+//
+
+import Foundation // iOS 14.0+
+
+// MARK: - Registry Constants
+private let TEMPORARY_FILE_DIRECTORY = "FantasyGM/Operations"
+
+// MARK: - Temporary File Scope
+/// The temporary files one operation holds. Every file made while the scope is current, and
+/// every file it retains, is released when the scope closes and deleted once no other scope
+/// holds it. Task groups inside `withValue` inherit the scope, so concurrent stages share it.
+final class TemporaryFileScope {
+    @TaskLocal static var current: TemporaryFileScope?
+    
+    private let registry: TemporaryFileRegistry
+    private let lock = NSLock()
+    private var files: Set<String> = []
+    private var isClosed = false
+    
+    fileprivate init(registry: TemporaryFileRegistry) {
+        self.registry = registry
+    }
+    
+    /// Holds a file another operation created until this scope closes. Returns false for files
+    /// the registry does not manage, such as caller-supplied inputs, which are never deleted.
+    @discardableResult
+    func retain(_ url: URL) -> Bool {
+        guard let name = registry.managedName(of: url) else { return false }
+        
+        lock.lock()
+        defer { lock.unlock() }
+        guard !isClosed, !files.contains(name) else { return !isClosed }
+        files.insert(name)
+        registry.retain(name)
+        return true
+    }
+    
+    /// Hands the file to the caller: this scope stops holding it without deleting it. A file no
+    /// scope holds stays until the next launch.
+    func keep(_ url: URL) {
+        guard let name = registry.managedName(of: url) else { return }
+        
+        lock.lock()
+        let held = files.remove(name) != nil
+        lock.unlock()
+        
+        if held {
+            registry.release(name, deleting: false)
+        }
+    }
+    
+    /// Releases every file; ones no other scope holds are deleted on the registry's cleanup queue
+    func close() {
+        lock.lock()
+        let released = files
+        files.removeAll()
+        isClosed = true
+        lock.unlock()
+        
+        released.forEach { registry.release($0, deleting: true) }
+    }
+    
+    deinit {
+        close()
+    }
+}
+
+// MARK: - Temporary File Registry
+/// Owns one directory under tmp and tracks who holds each file in it, so finishing an operation
+/// deletes exactly its own files instead of listing the directory, and nothing deletes a file
+/// another operation is still reading or writing. Deletes run on a background queue.
+final class TemporaryFileRegistry {
+    static let shared = TemporaryFileRegistry(
+        directory: FileManager.default.temporaryDirectory.appendingPathComponent(TEMPORARY_FILE_DIRECTORY)
+    )
+    
+    let directory: URL
+    private let fileManager = FileManager.default
+    private let cleanupQueue = DispatchQueue(label: "com.fantasygm.temporaryfiles", qos: .background)
+    private let lock = NSLock()
+    /// Scopes holding each file, by file name; files no scope holds have no entry
+    private var referenceCounts: [String: Int] = [:]
+    
+    init(directory: URL) {
+        self.directory = directory.standardizedFileURL
+        try? fileManager.createDirectory(at: self.directory, withIntermediateDirectories: true)
+        removeFilesFromEarlierLaunches()
+    }
+    
+    // MARK: - Scopes
+    func makeScope() -> TemporaryFileScope {
+        return TemporaryFileScope(registry: self)
+    }
+    
+    /// A new, not yet created file path, held by the current scope if there is one. Without a
+    /// scope the file belongs to the caller.
+    func makeURL(pathExtension: String) -> URL {
+        let url = directory.appendingPathComponent(UUID().uuidString).appendingPathExtension(pathExtension)
+        TemporaryFileScope.current?.retain(url)
+        return url
+    }
+    
+    /// True while at least one scope holds the file
+    func isInUse(_ url: URL) -> Bool {
+        guard let name = managedName(of: url) else { return false }
+        lock.lock()
+        defer { lock.unlock() }
+        return referenceCounts[name] != nil
+    }
+    
+    // MARK: - Reference Counting
+    /// The file name for files directly inside `directory`, nil for anything else
+    fileprivate func managedName(of url: URL) -> String? {
+        let standardized = url.standardizedFileURL
+        guard standardized.deletingLastPathComponent().path == directory.path else { return nil }
+        return standardized.lastPathComponent
+    }
+    
+    fileprivate func retain(_ name: String) {
+        lock.lock()
+        referenceCounts[name, default: 0] += 1
+        lock.unlock()
+    }
+    
+    fileprivate func release(_ name: String, deleting: Bool) {
+        lock.lock()
+        let remaining = (referenceCounts[name] ?? 1) - 1
+        referenceCounts[name] = remaining > 0 ? remaining : nil
+        lock.unlock()
+        
+        guard remaining <= 0, deleting else { return }
+        cleanupQueue.async {
+            // Another scope may have retained the file since it was released
+            guard !self.isInUse(self.directory.appendingPathComponent(name)) else { return }
+            try? self.fileManager.removeItem(at: self.directory.appendingPathComponent(name))
+        }
+    }
+    
+    // MARK: - Private Methods
+    /// Files left by a crash or handed to callers in an earlier launch. Only files older than
+    /// this registry are removed, so paths made while the sweep runs are safe.
+    private func removeFilesFromEarlierLaunches() {
+        let startDate = Date()
+        cleanupQueue.async {
+            let files = (try? self.fileManager.contentsOfDirectory(at: self.directory,
+                                                                   includingPropertiesForKeys: [.creationDateKey],
+                                                                   options: [.skipsHiddenFiles])) ?? []
+            var removed = 0
+            for file in files {
+                let created = (try? file.resourceValues(forKeys: [.creationDateKey]))?.creationDate
+                guard let created = created, created < startDate, !self.isInUse(file) else { continue }
+                if (try? self.fileManager.removeItem(at: file)) != nil {
+                    removed += 1
+                }
+            }
+            if removed > 0 {
+                Logger.shared.debug("Removed \(removed) temporary files from earlier launches")
+            }
+        }
+    }
+}
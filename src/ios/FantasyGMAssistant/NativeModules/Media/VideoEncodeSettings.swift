@@ -0,0 +1,165 @@
+//
+// VideoEncodeSettings.swift
+// FantasyGMAssistant
+//
+// Encoder and rate-control selection for FFmpeg re-encodes
+// Version: 1.0.0
+//
+
+import Foundation // iOS 14.0+
+
+// MARK: - Encode Constants
+private let AUDIO_BITRATE = 128_000
+/// Container overhead and rate-control overshoot kept free under `maxFileSize`
+private let FILE_SIZE_HEADROOM = 0.92
+private let MIN_VIDEO_BITRATE = 500_000
+
+// MARK: - Video Encoder
+enum VideoEncoder: Equatable {
+    case hevcVideoToolbox
+    case h264VideoToolbox
+    case x264
+    
+    var codecName: String {
+        switch self {
+        case .hevcVideoToolbox: return "hevc_videotoolbox"
+        case .h264VideoToolbox: return "h264_videotoolbox"
+        case .x264: return "libx264"
+        }
+    }
+    
+    var isHardware: Bool {
+        return self != .x264
+    }
+}
+
+// MARK: - Rate Control
+enum VideoRateControl: Equatable {
+    /// x264 only; output size follows content complexity
+    case constantQuality(crf: Int)
+    /// Average bits per second, capped so the output stays within the file size budget
+    case targetBitrate(Int)
+}
+
+// MARK: - Encode Settings
+/// Hardware encoders are used whenever the device has them: they keep the CPU free and run cool
+/// for the full clip, where `libx264 -preset slow` pins every core. x264 remains the fallback
+/// for the simulator and for failed hardware sessions, such as encoding while backgrounded.
+struct VideoEncodeSettings: Equatable {
+    let encoder: VideoEncoder
+    let rateControl: VideoRateControl
+    /// x264 speed preset; unused by hardware encoders
+    let preset: String
+    /// Taller sources are scaled down to this height; nil keeps the source resolution
+    var maxHeight: Int? = nil
+    
+    static func select(for options: MediaProcessingOptions,
+                       duration: TimeInterval,
+                       capabilities: DeviceCapabilities = .current()) -> VideoEncodeSettings {
+        guard capabilities.supportsHardwareEncoding else {
+            return software(for: options, duration: duration, capabilities: capabilities)
+        }
+        
+        // HEVC halves the bitrate for the same quality but costs more encoder time, so it is only
+        // used for high quality while the device has thermal headroom
+        let profile = PerformanceProfile(capabilities: capabilities)
+        let useHEVC = capabilities.supportsHEVCEncoding && options.quality == "high" && !profile.isConstrained
+        let encoder: VideoEncoder = useHEVC ? .hevcVideoToolbox : .h264VideoToolbox
+        
+        // VideoToolbox has no constant-quality mode reachable from FFmpeg, so it always targets a bitrate
+        return VideoEncodeSettings(encoder: encoder,
+                                   rateControl: .targetBitrate(targetBitrate(for: options, duration: duration)),
+                                   preset: "",
+                                   maxHeight: maxHeight(for: profile))
+    }
+    
+    static func software(for options: MediaProcessingOptions,
+                         duration: TimeInterval,
+                         capabilities: DeviceCapabilities = .current()) -> VideoEncodeSettings {
+        var preset: String
+        let crf: Int
+        switch options.quality {
+        case "high":
+            preset = "slow"
+            crf = 22
+        case "medium":
+            preset = "medium"
+            crf = 23
+        default:
+            preset = "fast"
+            crf = 24
+        }
+        
+        // A hot or power-saving device cannot afford the slower presets for a whole clip, and a
+        // low-tier one cannot afford `slow` even when cool
+        let profile = PerformanceProfile(capabilities: capabilities)
+        if profile.isConstrained {
+            preset = "veryfast"
+        } else if profile.level == .minimal && preset == "slow" {
+            preset = "medium"
+        }
+        
+        let rateControl: VideoRateControl = options.optimization == "size"
+            ? .targetBitrate(targetBitrate(for: options, duration: duration))
+            : .constantQuality(crf: crf)
+        return VideoEncodeSettings(encoder: .x264, rateControl: rateControl, preset: preset,
+                                   maxHeight: maxHeight(for: profile))
+    }
+    
+    /// Encode time scales with pixel count, so lower levels cap the output resolution
+    static func maxHeight(for profile: PerformanceProfile) -> Int? {
+        switch profile.level {
+        case .full: return nil
+        case .reduced: return 1080
+        case .minimal: return 720
+        }
+    }
+    
+    /// Video bitrate that keeps `duration` seconds plus audio under `maxFileSize`, and no higher
+    /// than the quality level needs
+    static func targetBitrate(for options: MediaProcessingOptions, duration: TimeInterval) -> Int {
+        let qualityCeiling: Int
+        switch options.quality {
+        case "high": qualityCeiling = 8_000_000
+        case "medium": qualityCeiling = 5_000_000
+        default: qualityCeiling = 2_500_000
+        }
+        
+        let seconds = duration > 0 ? min(duration, options.maxDuration) : options.maxDuration
+        guard seconds > 0, options.maxFileSize > 0 else { return qualityCeiling }
+        
+        let budget = Double(options.maxFileSize) * 8 * FILE_SIZE_HEADROOM / seconds - Double(AUDIO_BITRATE)
+        return max(MIN_VIDEO_BITRATE, min(qualityCeiling, Int(budget)))
+    }
+    
+    /// Video codec arguments for an FFmpeg command line
+    var ffmpegArguments: String {
+        var arguments = "-c:v \(encoder.codecName) "
+        if encoder == .x264 {
+            arguments += "-preset \(preset) "
+        }
+        
+        switch rateControl {
+        case .constantQuality(let crf):
+            arguments += "-crf \(crf) "
+        case .targetBitrate(let bitrate):
+            // A one-second buffer keeps peaks close to the average so the size budget holds
+            arguments += "-b:v \(bitrate) -maxrate \(bitrate) -bufsize \(bitrate) "
+        }
+        
+        if let maxHeight = maxHeight {
+            // Only ever scales down; the width keeps the aspect ratio and stays even
+            arguments += "-vf scale=-2:min(ih\\,\(maxHeight)) "
+        }
+        
+        if encoder == .hevcVideoToolbox {
+            // Tagged hvc1 so AVFoundation and the Photos app play the result
+            arguments += "-tag:v hvc1 "
+        }
+        return arguments
+    }
+    
+    static var audioArguments: String {
+        return "-c:a aac -b:a \(AUDIO_BITRATE / 1000)k "
+    }
+}
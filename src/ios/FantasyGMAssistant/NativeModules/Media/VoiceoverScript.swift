@@ -0,0 +1,57 @@
+//
+// VoiceoverScript.swift
+// FantasyGMAssistant
+//
+// Splits voiceover scripts into synthesis-sized chunks at sentence boundaries
+// Version: 1.0.0
+//
+
+import Foundation // iOS 14.0+
+
+// MARK: - Script Constants
+/// Well under the synthesis API's per-request limit, so chunks return quickly and in parallel
+private let VOICE_CHUNK_MAX_CHARACTERS = 1500
+
+// MARK: - Voiceover Script
+enum VoiceoverScript {
+    /// Packs whole sentences into chunks of at most `maxLength` characters. A sentence longer than
+    /// that is split between words, and a single word longer still is split where it overflows.
+    static func chunks(of text: String, maxLength: Int = VOICE_CHUNK_MAX_CHARACTERS) -> [String] {
+        var chunks: [String] = []
+        var current = ""
+        
+        func append(_ piece: String) {
+            if current.isEmpty {
+                current = piece
+            } else if current.count + 1 + piece.count <= maxLength {
+                current += " " + piece
+            } else {
+                chunks.append(current)
+                current = piece
+            }
+        }
+        
+        text.enumerateSubstrings(in: text.startIndex..., options: .bySentences) { sentence, _, _, _ in
+            guard let sentence = sentence?.trimmingCharacters(in: .whitespacesAndNewlines),
+                  !sentence.isEmpty else { return }
+            
+            guard sentence.count > maxLength else {
+                append(sentence)
+                return
+            }
+            for word in sentence.split(whereSeparator: { $0.isWhitespace }) {
+                var remainder = Substring(word)
+                while remainder.count > maxLength {
+                    append(String(remainder.prefix(maxLength)))
+                    remainder = remainder.dropFirst(maxLength)
+                }
+                append(String(remainder))
+            }
+        }
+        
+        if !current.isEmpty {
+            chunks.append(current)
+        }
+        return chunks
+    }
+}
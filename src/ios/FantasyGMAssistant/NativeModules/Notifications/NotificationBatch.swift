@@ -0,0 +1,84 @@
+//
+// NotificationBatch.swift
+// FantasyGMAssistant
+//
+// Pushes received within one batching window, merged per player, game or trade
+// Version: 1.0.0
+//
+
+import Foundation // iOS 14.0+
+import UserNotifications // iOS 14.0+
+
+// MARK: - Batch Constants
+/// Payload fields that identify what an alert is about, tried in order. Alerts of a category
+/// without one, or missing every field, are never merged.
+private let NOTIFICATION_DEDUPLICATION_FIELDS: [String: [String]] = [
+    "INJURY_ALERT": ["player_id", "player"],
+    "GAME_START": ["game_id"],
+    "TRADE_PROPOSAL": ["trade_id"]
+]
+
+// MARK: - Merged Notification
+/// Every push in a batch about the same player, game or trade
+struct MergedNotification {
+    let categoryIdentifier: String
+    /// The most recently received copy, which carries the newest details
+    let content: UNNotificationContent
+    let count: Int
+}
+
+// MARK: - Notification Batch
+struct NotificationBatch {
+    private(set) var received = 0
+    /// Badge from the last push in the batch that set one
+    private(set) var badge: Int?
+    /// Pushes per category, before merging
+    private(set) var categoryCounts: [String: Int] = [:]
+    private var merged: [String: MergedNotification] = [:]
+    /// Keys in order of first arrival
+    private var keys: [String] = []
+    
+    var isEmpty: Bool {
+        return received == 0
+    }
+    
+    /// Merged alerts, in the order their subjects first appeared
+    var alerts: [MergedNotification] {
+        return keys.compactMap { merged[$0] }
+    }
+    
+    mutating func append(_ content: UNNotificationContent, identifier: String) {
+        let category = content.categoryIdentifier
+        received += 1
+        categoryCounts[category, default: 0] += 1
+        if let badge = content.badge?.intValue {
+            self.badge = badge
+        }
+        
+        let key = Self.deduplicationKey(category: category, userInfo: content.userInfo, identifier: identifier)
+        let count = (merged[key]?.count ?? 0) + 1
+        if count == 1 {
+            keys.append(key)
+        }
+        merged[key] = MergedNotification(categoryIdentifier: category, content: content, count: count)
+    }
+    
+    /// One line for the whole batch, e.g. "14 pushes as 3 alerts (GAME_START: 2, INJURY_ALERT: 12)"
+    var summary: String {
+        let categories = categoryCounts.sorted { $0.key < $1.key }
+            .map { "\($0.key.isEmpty ? "uncategorized" : $0.key): \($0.value)" }
+            .joined(separator: ", ")
+        return "\(received) pushes as \(keys.count) alerts (\(categories))"
+    }
+    
+    // MARK: - Private Methods
+    private static func deduplicationKey(category: String, userInfo: [AnyHashable: Any], identifier: String) -> String {
+        let fields = NOTIFICATION_DEDUPLICATION_FIELDS[category] ?? []
+        for field in fields {
+            if let value = userInfo[field] {
+                return "\(category)|\(field)|\(value)"
+            }
+        }
+        return "\(category)|id|\(identifier)"
+    }
+}
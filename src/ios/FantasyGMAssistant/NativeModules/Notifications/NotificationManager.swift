@@ -11,13 +11,27 @@ import UserNotifications // iOS 14.0+
 import UIKit // iOS 14.0+
 import Constants
 
+// MARK: - Batching Constants
+/// Pushes arriving this close together are handled as one batch
+private let NOTIFICATION_BATCH_WINDOW: TimeInterval = 0.25
+/// Delivery counts are sent to analytics at most this often, and when the app is backgrounded
+private let DELIVERY_REPORT_INTERVAL: TimeInterval = 60
+private let DELIVERY_REPORT_EVENT = "notification_delivery"
+
 @objc public final class NotificationManager: NSObject {
     // MARK: - Properties
     private let notificationCenter: UNUserNotificationCenter
     private let serialQueue: DispatchQueue
-    private var currentBadgeCount: Int
     private var notificationCategories: [String: UNNotificationCategory]
+    /// Pushes per category since the last analytics report
     private var deliveryAnalytics: [String: Int]
+    private var pendingBatch = NotificationBatch()
+    private var isBatchScheduled = false
+    private var isDeliveryReportScheduled = false
+    /// Guards the badge state, which is written from any thread and applied on the main thread
+    private let badgeLock = NSLock()
+    private var currentBadgeCount: Int
+    private var isBadgeUpdateScheduled = false
     
     // Singleton instance
     @objc public static let shared = NotificationManager()
@@ -34,6 +48,13 @@ import Constants
         
         Logger.shared.debug("NotificationManager initialized")
         setupDefaultCategories()
+        
+        // Counts still waiting for the report interval would be lost if the app is then terminated
+        NotificationCenter.default.addObserver(forName: UIApplication.didEnterBackgroundNotification,
+                                               object: nil,
+                                               queue: nil) { [weak self] _ in
+            self?.serialQueue.async { self?.reportDeliveries() }
+        }
     }
     
     // MARK: - Private Methods
@@ -143,51 +164,96 @@ import Constants
         }
     }
     
+    /// Calls in the same main queue turn are coalesced into one update with the latest count
     @objc public func updateBadgeCount(_ count: Int) {
-        serialQueue.async {
-            self.currentBadgeCount = count
+        badgeLock.lock()
+        currentBadgeCount = count
+        let needsScheduling = !isBadgeUpdateScheduled
+        isBadgeUpdateScheduled = true
+        badgeLock.unlock()
+        
+        guard needsScheduling else { return }
+        DispatchQueue.main.async {
+            self.badgeLock.lock()
+            let count = self.currentBadgeCount
+            self.isBadgeUpdateScheduled = false
+            self.badgeLock.unlock()
             
-            DispatchQueue.main.async {
-                UIApplication.shared.applicationIconBadgeNumber = count
-                Logger.shared.debug("Updated application badge count to \(count)")
-            }
+            guard UIApplication.shared.applicationIconBadgeNumber != count else { return }
+            UIApplication.shared.applicationIconBadgeNumber = count
+            Logger.shared.debug("Updated application badge count to \(count)")
         }
     }
     
+    /// Pushes are queued for `NOTIFICATION_BATCH_WINDOW` and handled as one batch, so a game-day
+    /// burst costs one pass, one badge update and one log line instead of one per push
     @objc public func handleNotificationReceived(_ notification: UNNotification) {
         serialQueue.async {
-            let content = notification.request.content
-            let categoryId = content.categoryIdentifier
+            self.pendingBatch.append(notification.request.content, identifier: notification.request.identifier)
+            guard !self.isBatchScheduled else { return }
             
-            // Track notification delivery
-            self.deliveryAnalytics[categoryId, default: 0] += 1
-            
-            Logger.shared.info("Received notification: \(categoryId)")
-            
-            // Handle rich media attachments
-            if let attachments = content.attachments {
-                for attachment in attachments {
-                    Logger.shared.debug("Processing attachment: \(attachment.identifier)")
-                }
+            self.isBatchScheduled = true
+            self.serialQueue.asyncAfter(deadline: .now() + NOTIFICATION_BATCH_WINDOW) {
+                self.processPendingBatch()
             }
-            
-            // Update badge count if specified
-            if let badgeCount = content.badge as? Int {
-                self.updateBadgeCount(badgeCount)
-            }
-            
-            // Process category-specific handling
-            switch categoryId {
+        }
+    }
+    
+    // MARK: - Batch Processing
+    /// Must run on `serialQueue`
+    private func processPendingBatch() {
+        let batch = pendingBatch
+        pendingBatch = NotificationBatch()
+        isBatchScheduled = false
+        guard !batch.isEmpty else { return }
+        
+        // Track notification delivery
+        for (categoryId, count) in batch.categoryCounts {
+            deliveryAnalytics[categoryId, default: 0] += count
+        }
+        scheduleDeliveryReport()
+        
+        // Duplicate pushes about one player, game or trade are handled once, with the newest payload
+        for alert in batch.alerts {
+            switch alert.categoryIdentifier {
             case "INJURY_ALERT":
-                self.handleInjuryAlert(content)
+                handleInjuryAlert(alert.content)
             case "TRADE_PROPOSAL":
-                self.handleTradeProposal(content)
+                handleTradeProposal(alert.content)
             case "GAME_START":
-                self.handleGameStart(content)
+                handleGameStart(alert.content)
             default:
-                Logger.shared.debug("Received notification with unknown category: \(categoryId)")
+                break
             }
         }
+        
+        if let badgeCount = batch.badge {
+            updateBadgeCount(badgeCount)
+        }
+        Logger.shared.debug("Processed notification batch: \(batch.summary)")
+    }
+    
+    /// Must run on `serialQueue`
+    private func scheduleDeliveryReport() {
+        guard !isDeliveryReportScheduled else { return }
+        
+        isDeliveryReportScheduled = true
+        serialQueue.asyncAfter(deadline: .now() + DELIVERY_REPORT_INTERVAL) {
+            self.isDeliveryReportScheduled = false
+            self.reportDeliveries()
+        }
+    }
+    
+    /// Sends and resets the per-category counts as one event. Must run on `serialQueue`.
+    private func reportDeliveries() {
+        guard !deliveryAnalytics.isEmpty else { return }
+        
+        let counts = deliveryAnalytics
+        deliveryAnalytics.removeAll()
+        AnalyticsManager.shared.trackEvent(DELIVERY_REPORT_EVENT, parameters: [
+            "deliveries": counts,
+            "total": counts.values.reduce(0, +)
+        ])
     }
     
     // MARK: - Category-Specific Handlers
@@ -0,0 +1,76 @@
+//
+// DeviceCapabilities.swift
+// FantasyGMAssistant
+//
+// Snapshot of device hardware and thermal conditions used to pick workload strategies
+// Version: 1.0.0
+//
+
+import Foundation // iOS 14.0+
+import AVFoundation // iOS 14.0+
+import UIKit // iOS 14.0+
+
+// MARK: - Device Class
+public enum DeviceClass: Int {
+    case low = 0
+    case mid = 1
+    case high = 2
+}
+
+// MARK: - Device Capabilities
+/// Read fresh on each call since thermal state and Low Power Mode change while the app runs
+public struct DeviceCapabilities {
+    public let processorCount: Int
+    public let physicalMemory: UInt64
+    public let thermalState: ProcessInfo.ThermalState
+    public let isLowPowerModeEnabled: Bool
+    /// Every supported device has a hardware H.264 encoder; the simulator has none
+    public let supportsHardwareEncoding: Bool
+    /// HEVC hardware encode (A10 and later), detected through the export presets it enables
+    public let supportsHEVCEncoding: Bool
+    
+    public static func current() -> DeviceCapabilities {
+        let processInfo = ProcessInfo.processInfo
+        #if targetEnvironment(simulator)
+        let hardwareEncoding = false
+        #else
+        let hardwareEncoding = true
+        #endif
+        
+        return DeviceCapabilities(
+            processorCount: processInfo.processorCount,
+            physicalMemory: processInfo.physicalMemory,
+            thermalState: processInfo.thermalState,
+            isLowPowerModeEnabled: processInfo.isLowPowerModeEnabled,
+            supportsHardwareEncoding: hardwareEncoding,
+            supportsHEVCEncoding: hardwareEncoding &&
+                AVAssetExportSession.allExportPresets().contains(AVAssetExportPresetHEVCHighestQuality)
+        )
+    }
+    
+    /// Coarse tier for sizing concurrent workloads
+    public var deviceClass: DeviceClass {
+        if processorCount >= 6 && physicalMemory >= 4_000_000_000 {
+            return .high
+        }
+        return processorCount >= 4 && physicalMemory >= 3_000_000_000 ? .mid : .low
+    }
+    
+    /// Sustained heavy work should be scaled back from `.serious` on
+    public var isThermallyConstrained: Bool {
+        return thermalState == .serious || thermalState == .critical
+    }
+    
+    var dictionaryRepresentation: [String: Any] {
+        return [
+            "processorCount": processorCount,
+            "physicalMemory": physicalMemory,
+            "thermalState": thermalState.rawValue,
+            "isLowPowerModeEnabled": isLowPowerModeEnabled,
+            "deviceClass": deviceClass.rawValue,
+            "supportsHardwareEncoding": supportsHardwareEncoding,
+            "supportsHEVCEncoding": supportsHEVCEncoding,
+            "systemVersion": UIDevice.current.systemVersion
+        ]
+    }
+}
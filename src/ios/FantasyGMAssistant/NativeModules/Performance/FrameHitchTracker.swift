@@ -0,0 +1,196 @@
+//
+// FrameHitchTracker.swift
+// FantasyGMAssistant
+//
+// CADisplayLink-based frame-time histogram and hitch attribution by screen and span
+// Version: 1.0.0
+//
+
+import Foundation // iOS 14.0+
+import QuartzCore // iOS 14.0+
+import UIKit // iOS 14.0+
+
+// MARK: - Tracker Constants
+/// Upper bounds in milliseconds; the last bucket takes everything slower
+private let FRAME_HISTOGRAM_BOUNDS: [Double] = [8.4, 16.7, 25, 33.4, 50, 100, 250]
+/// A frame counts as a hitch once it runs this far past its expected interval
+private let HITCH_TOLERANCE: Double = 0.5
+/// Gaps this long are app suspension or a paused link, not jank
+private let MAX_TRACKED_FRAME_DURATION: CFTimeInterval = 1.0
+private let FRAME_RATE_SMOOTHING: Double = 0.1
+
+// MARK: - Frame Stats
+struct FrameStats {
+    private(set) var frames: UInt64 = 0
+    private(set) var droppedFrames: UInt64 = 0
+    private(set) var hitches: UInt64 = 0
+    private(set) var duration: CFTimeInterval = 0
+    /// Time spent past the expected interval on hitched frames
+    private(set) var hitchDuration: CFTimeInterval = 0
+    
+    mutating func record(duration frameDuration: CFTimeInterval, expected: CFTimeInterval) {
+        frames += 1
+        duration += frameDuration
+        
+        let late = frameDuration - expected
+        guard late > expected * HITCH_TOLERANCE else { return }
+        hitches += 1
+        hitchDuration += late
+        droppedFrames += UInt64(max(0, (frameDuration / expected).rounded() - 1))
+    }
+    
+    /// Share of the frames the display could have shown that the app missed
+    var droppedFrameRatio: Double {
+        let expectedFrames = frames + droppedFrames
+        return expectedFrames > 0 ? Double(droppedFrames) / Double(expectedFrames) : 0
+    }
+    
+    var dictionaryRepresentation: [String: Any] {
+        return [
+            "frames": frames,
+            "dropped_frames": droppedFrames,
+            "dropped_frame_ratio": droppedFrameRatio,
+            "hitches": hitches,
+            // Apple's hitch time ratio: milliseconds of hitch per second of frames
+            "hitch_ms_per_second": duration > 0 ? hitchDuration * 1000 / duration : 0
+        ]
+    }
+}
+
+// MARK: - Frame Hitch Tracker
+/// Measures real frame delivery instead of the display's maximum rate. Each frame costs one
+/// timestamp subtraction and a few counter updates, and is attributed to the screen and span
+/// active when it was delivered.
+final class FrameHitchTracker {
+    private let lock = NSLock()
+    private var displayLink: CADisplayLink?
+    private var lastTimestamp: CFTimeInterval?
+    private var histogram = [UInt64](repeating: 0, count: FRAME_HISTOGRAM_BOUNDS.count + 1)
+    private var totals = FrameStats()
+    private var screenStats: [String: FrameStats] = [:]
+    private var spanStats: [String: FrameStats] = [:]
+    private var activeScreen: String?
+    /// Most recently begun span last; frames are attributed to it
+    private var activeSpans: [String] = []
+    private var smoothedFrameDuration: CFTimeInterval?
+    
+    /// Safe to call from any thread; the display link always runs on the main run loop
+    func start() {
+        DispatchQueue.main.async {
+            guard self.displayLink == nil else { return }
+            let proxy = DisplayLinkProxy(self)
+            let link = CADisplayLink(target: proxy, selector: #selector(DisplayLinkProxy.tick(_:)))
+            link.add(to: .main, forMode: .common)
+            self.displayLink = link
+        }
+    }
+    
+    func stop() {
+        DispatchQueue.main.async {
+            self.displayLink?.invalidate()
+            self.displayLink = nil
+            self.lastTimestamp = nil
+        }
+    }
+    
+    // MARK: - Attribution
+    func setActiveScreen(_ name: String?) {
+        lock.lock()
+        activeScreen = name
+        lock.unlock()
+    }
+    
+    func beginSpan(_ name: String) {
+        lock.lock()
+        activeSpans.append(name)
+        lock.unlock()
+    }
+    
+    /// Ends the most recent span with this name; unmatched names are ignored
+    func endSpan(_ name: String) {
+        lock.lock()
+        if let index = activeSpans.lastIndex(of: name) {
+            activeSpans.remove(at: index)
+        }
+        lock.unlock()
+    }
+    
+    // MARK: - Readings
+    /// Delivered frames per second, smoothed over roughly the last ten frames; nil until measured
+    var frameRate: Float? {
+        lock.lock()
+        defer { lock.unlock() }
+        return smoothedFrameDuration.map { Float(1 / $0) }
+    }
+    
+    var dictionaryRepresentation: [String: Any] {
+        lock.lock()
+        defer { lock.unlock() }
+        
+        var buckets: [String: UInt64] = [:]
+        for (index, count) in histogram.enumerated() {
+            let label = index < FRAME_HISTOGRAM_BOUNDS.count
+                ? "le_\(FRAME_HISTOGRAM_BOUNDS[index])ms"
+                : "gt_\(FRAME_HISTOGRAM_BOUNDS[FRAME_HISTOGRAM_BOUNDS.count - 1])ms"
+            buckets[label] = count
+        }
+        
+        var representation = totals.dictionaryRepresentation
+        representation["histogram"] = buckets
+        representation["screens"] = screenStats.mapValues { $0.dictionaryRepresentation }
+        representation["spans"] = spanStats.mapValues { $0.dictionaryRepresentation }
+        return representation
+    }
+    
+    // MARK: - Recording
+    /// Records one frame that took `duration` against an expected refresh interval of `expected`
+    func recordFrame(duration: CFTimeInterval, expected: CFTimeInterval) {
+        guard duration > 0, duration < MAX_TRACKED_FRAME_DURATION, expected > 0 else { return }
+        
+        let milliseconds = duration * 1000
+        let bucket = FRAME_HISTOGRAM_BOUNDS.firstIndex { milliseconds <= $0 } ?? FRAME_HISTOGRAM_BOUNDS.count
+        
+        lock.lock()
+        histogram[bucket] += 1
+        totals.record(duration: duration, expected: expected)
+        if let screen = activeScreen {
+            screenStats[screen, default: FrameStats()].record(duration: duration, expected: expected)
+        }
+        if let span = activeSpans.last {
+            spanStats[span, default: FrameStats()].record(duration: duration, expected: expected)
+        }
+        smoothedFrameDuration = smoothedFrameDuration.map {
+            $0 + (duration - $0) * FRAME_RATE_SMOOTHING
+        } ?? duration
+        lock.unlock()
+    }
+    
+    // MARK: - Private Methods
+    /// Main thread only
+    fileprivate func tick(_ link: CADisplayLink) {
+        defer { lastTimestamp = link.timestamp }
+        guard let lastTimestamp = lastTimestamp else { return }
+        
+        // The target interval follows ProMotion and Low Power Mode rate changes
+        recordFrame(duration: link.timestamp - lastTimestamp, expected: link.targetTimestamp - link.timestamp)
+    }
+}
+
+// MARK: - Display Link Proxy
+/// CADisplayLink retains its target; the proxy keeps the tracker from being retained by the run loop
+private final class DisplayLinkProxy: NSObject {
+    private weak var tracker: FrameHitchTracker?
+    
+    init(_ tracker: FrameHitchTracker) {
+        self.tracker = tracker
+        super.init()
+    }
+    
+    @objc func tick(_ link: CADisplayLink) {
+        guard let tracker = tracker else {
+            link.invalidate()
+            return
+        }
+        tracker.tick(link)
+    }
+}
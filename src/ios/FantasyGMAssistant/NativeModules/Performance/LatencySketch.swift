@@ -0,0 +1,186 @@
+//
+// LatencySketch.swift
+// FantasyGMAssistant
+//
+// Mergeable streaming quantile sketch for operation latencies
+// Version: 1.0.0
+//
+
+import Foundation // iOS 14.0+
+
+// MARK: - Sketch Constants
+/// Values below this are counted as zero; log buckets cannot represent them
+private let SKETCH_MIN_INDEXABLE_VALUE = 1e-9
+
+// MARK: - Latency Sketch
+/// DDSketch: values fall into logarithmic buckets whose width is a fixed share of their value, so
+/// any quantile is returned within `relativeAccuracy` of the true value. Recording does not
+/// allocate once a latency range has been seen, memory is bounded by `maxBins`, and two sketches
+/// with the same accuracy merge exactly by adding bucket counts. If the range outgrows `maxBins`,
+/// the lowest buckets are folded together, so only the fastest timings lose precision.
+struct LatencySketch {
+    static let defaultRelativeAccuracy = 0.01
+    /// 2048 buckets at 1% accuracy span about 1e-9s to 1e8s, so folding never happens for latencies
+    static let defaultMaxBins = 2048
+    
+    let relativeAccuracy: Double
+    let maxBins: Int
+    private(set) var count: UInt64 = 0
+    private(set) var sum: Double = 0
+    private(set) var min = Double.infinity
+    private(set) var max = -Double.infinity
+    
+    private let gamma: Double
+    private let logGamma: Double
+    private var zeroCount: UInt64 = 0
+    /// Counts for consecutive bucket indices starting at `offset`
+    private var bins: [UInt64] = []
+    private var offset = 0
+    
+    init(relativeAccuracy: Double = LatencySketch.defaultRelativeAccuracy,
+         maxBins: Int = LatencySketch.defaultMaxBins) {
+        self.relativeAccuracy = Swift.min(Swift.max(relativeAccuracy, 0.0001), 0.5)
+        self.maxBins = Swift.max(1, maxBins)
+        gamma = (1 + self.relativeAccuracy) / (1 - self.relativeAccuracy)
+        logGamma = log(gamma)
+    }
+    
+    var isEmpty: Bool {
+        return count == 0
+    }
+    
+    var average: Double {
+        return count > 0 ? sum / Double(count) : 0
+    }
+    
+    // MARK: - Recording
+    /// Negative and non-finite values are ignored
+    mutating func record(_ value: Double) {
+        guard value.isFinite, value >= 0 else { return }
+        
+        count += 1
+        sum += value
+        min = Swift.min(min, value)
+        max = Swift.max(max, value)
+        
+        if value < SKETCH_MIN_INDEXABLE_VALUE {
+            zeroCount += 1
+        } else {
+            increment(bucketIndex(for: value), by: 1)
+        }
+    }
+    
+    /// Returns false, leaving this sketch unchanged, when the accuracies differ
+    @discardableResult
+    mutating func merge(_ other: LatencySketch) -> Bool {
+        guard other.relativeAccuracy == relativeAccuracy else { return false }
+        guard !other.isEmpty else { return true }
+        
+        count += other.count
+        sum += other.sum
+        min = Swift.min(min, other.min)
+        max = Swift.max(max, other.max)
+        zeroCount += other.zeroCount
+        for (position, binCount) in other.bins.enumerated() where binCount > 0 {
+            increment(other.offset + position, by: binCount)
+        }
+        return true
+    }
+    
+    // MARK: - Queries
+    /// `q` in 0...1; nil when empty. Always within `min...max`.
+    func quantile(_ q: Double) -> Double? {
+        guard count > 0, q >= 0, q <= 1 else { return nil }
+        
+        let rank = q * Double(count - 1)
+        var cumulative = Double(zeroCount)
+        guard cumulative <= rank else { return min }
+        
+        for (position, binCount) in bins.enumerated() where binCount > 0 {
+            cumulative += Double(binCount)
+            if cumulative > rank {
+                return Swift.min(Swift.max(value(at: offset + position), min), max)
+            }
+        }
+        return max
+    }
+    
+    // MARK: - Serialization
+    /// Upload form; sketches from different sessions and devices merge through `init?(dictionary:)`
+    var dictionaryRepresentation: [String: Any] {
+        return [
+            "relative_accuracy": relativeAccuracy,
+            "max_bins": maxBins,
+            "count": count,
+            "sum": sum,
+            "min": count > 0 ? min : 0,
+            "max": count > 0 ? max : 0,
+            "zero_count": zeroCount,
+            "offset": offset,
+            "bins": bins
+        ]
+    }
+    
+    init?(dictionary: [String: Any]) {
+        guard let accuracy = (dictionary["relative_accuracy"] as? NSNumber)?.doubleValue,
+              let count = (dictionary["count"] as? NSNumber)?.uint64Value,
+              let zeroCount = (dictionary["zero_count"] as? NSNumber)?.uint64Value,
+              let offset = (dictionary["offset"] as? NSNumber)?.intValue,
+              let bins = dictionary["bins"] as? [NSNumber] else {
+            return nil
+        }
+        
+        let maxBins = (dictionary["max_bins"] as? NSNumber)?.intValue ?? LatencySketch.defaultMaxBins
+        self.init(relativeAccuracy: accuracy, maxBins: maxBins)
+        guard self.relativeAccuracy == accuracy,
+              bins.count <= self.maxBins,
+              zeroCount + bins.reduce(0, { $0 + $1.uint64Value }) == count else {
+            return nil
+        }
+        
+        self.count = count
+        self.zeroCount = zeroCount
+        self.offset = offset
+        self.bins = bins.map { $0.uint64Value }
+        sum = (dictionary["sum"] as? NSNumber)?.doubleValue ?? 0
+        if count > 0 {
+            min = (dictionary["min"] as? NSNumber)?.doubleValue ?? 0
+            max = (dictionary["max"] as? NSNumber)?.doubleValue ?? 0
+        }
+    }
+    
+    // MARK: - Private Methods
+    private func bucketIndex(for value: Double) -> Int {
+        return Int(ceil(log(value) / logGamma))
+    }
+    
+    /// Midpoint of the bucket, which keeps the relative error within `relativeAccuracy`
+    private func value(at index: Int) -> Double {
+        return 2 * pow(gamma, Double(index)) / (gamma + 1)
+    }
+    
+    private mutating func increment(_ index: Int, by amount: UInt64) {
+        guard !bins.isEmpty else {
+            offset = index
+            bins = [amount]
+            return
+        }
+        
+        let high = Swift.max(index, offset + bins.count - 1)
+        let low = Swift.max(Swift.min(index, offset), high - maxBins + 1)
+        if low != offset || high != offset + bins.count - 1 {
+            resize(low: low, high: high)
+        }
+        bins[Swift.max(index, low) - offset] += amount
+    }
+    
+    /// Re-bases the buckets on `low...high`, folding any below `low` into it
+    private mutating func resize(low: Int, high: Int) {
+        var resized = [UInt64](repeating: 0, count: high - low + 1)
+        for (position, binCount) in bins.enumerated() where binCount > 0 {
+            resized[Swift.max(offset + position, low) - low] += binCount
+        }
+        bins = resized
+        offset = low
+    }
+}
@@ -0,0 +1,165 @@
+//
+// MemoryPressureCoordinator.swift
+// FantasyGMAssistant
+//
+// Coordinated, priority-tiered memory pressure response shared by native modules
+// Version: 1.0.0
+//
+
+import Foundation // iOS 14.0+
+import UIKit // iOS 14.0+
+
+// MARK: - Constants
+private let PRESSURE_DEBOUNCE_INTERVAL: TimeInterval = 1.0
+
+// MARK: - Pressure Levels
+@objc public enum MemoryPressureLevel: Int {
+    case normal = 0
+    case warning = 1
+    case critical = 2
+}
+
+/// Lower priorities are trimmed first and harder. Use `.high` for state that is expensive to rebuild.
+public enum MemoryTrimPriority: Int, CaseIterable {
+    case low = 0
+    case normal = 1
+    case high = 2
+}
+
+// MARK: - Participant Protocol
+public protocol MemoryPressureParticipant: AnyObject {
+    /// Releases roughly `fraction` (0...1) of the memory held, coldest entries first
+    func trimMemory(fraction: Double, level: MemoryPressureLevel)
+}
+
+// MARK: - Memory Pressure Coordinator
+/// Listens to kernel memory pressure events and UIKit memory warnings, and asks registered
+/// participants to shed a share of their memory based on priority instead of clearing everything.
+@objc public final class MemoryPressureCoordinator: NSObject {
+    // MARK: - Properties
+    @objc public static let shared = MemoryPressureCoordinator()
+    
+    private struct Registration {
+        weak var participant: MemoryPressureParticipant?
+        let name: String
+        let priority: MemoryTrimPriority
+    }
+    
+    private let queue = DispatchQueue(label: "com.fantasygm.memorypressure", qos: .utility)
+    private let lock = NSLock()
+    private let pressureSource: DispatchSourceMemoryPressure
+    private var registrations: [Registration] = []
+    private var lastTrim: (level: MemoryPressureLevel, date: Date)?
+    private let sharedURLCache = SharedURLCacheParticipant()
+    
+    // MARK: - Initialization
+    private override init() {
+        pressureSource = DispatchSource.makeMemoryPressureSource(eventMask: [.warning, .critical], queue: queue)
+        super.init()
+        
+        pressureSource.setEventHandler { [weak self] in
+            guard let self = self else { return }
+            let event = self.pressureSource.data
+            self.handlePressure(event.contains(.critical) ? .critical : .warning)
+        }
+        pressureSource.activate()
+        
+        // UIKit warnings usually accompany a kernel event; the debounce keeps them from trimming twice
+        NotificationCenter.default.addObserver(
+            self,
+            selector: #selector(handleMemoryWarning),
+            name: UIApplication.didReceiveMemoryWarningNotification,
+            object: nil
+        )
+        
+        register(sharedURLCache, name: "URLCache.shared", priority: .low)
+    }
+    
+    deinit {
+        pressureSource.cancel()
+        NotificationCenter.default.removeObserver(self)
+    }
+    
+    // MARK: - Public Methods
+    /// Registers a participant. It is held weakly and dropped automatically once deallocated.
+    public func register(_ participant: MemoryPressureParticipant, name: String, priority: MemoryTrimPriority) {
+        lock.lock()
+        defer { lock.unlock() }
+        
+        registrations.removeAll { $0.participant == nil || $0.participant === participant }
+        registrations.append(Registration(participant: participant, name: name, priority: priority))
+    }
+    
+    /// Trims every participant for the given level, lowest priority first. Shares the debounce
+    /// with the pressure source, so a request right after a system warning does not trim again.
+    @objc public func trim(for level: MemoryPressureLevel) {
+        queue.async { [weak self] in
+            self?.handlePressure(level)
+        }
+    }
+    
+    /// Share of memory a participant of `priority` should release at `level`
+    public static func trimFraction(for priority: MemoryTrimPriority, level: MemoryPressureLevel) -> Double {
+        switch (level, priority) {
+        case (.normal, _): return 0
+        case (.warning, .low): return 0.5
+        case (.warning, .normal): return 0.25
+        case (.warning, .high): return 0
+        case (.critical, .low): return 1.0
+        case (.critical, .normal): return 0.75
+        case (.critical, .high): return 0.5
+        }
+    }
+    
+    // MARK: - Private Methods
+    @objc private func handleMemoryWarning() {
+        queue.async { [weak self] in
+            self?.handlePressure(.warning)
+        }
+    }
+    
+    /// Runs on `queue`. Drops repeats of the same or a lower level inside the debounce window.
+    private func handlePressure(_ level: MemoryPressureLevel) {
+        if let last = lastTrim,
+           last.level.rawValue >= level.rawValue,
+           Date().timeIntervalSince(last.date) < PRESSURE_DEBOUNCE_INTERVAL {
+            return
+        }
+        performTrim(level)
+    }
+    
+    private func performTrim(_ level: MemoryPressureLevel) {
+        lastTrim = (level, Date())
+        
+        lock.lock()
+        registrations.removeAll { $0.participant == nil }
+        let targets = registrations.sorted { $0.priority.rawValue < $1.priority.rawValue }
+        lock.unlock()
+        
+        for registration in targets {
+            let fraction = MemoryPressureCoordinator.trimFraction(for: registration.priority, level: level)
+            guard fraction > 0, let participant = registration.participant else { continue }
+            participant.trimMemory(fraction: fraction, level: level)
+        }
+        
+        Logger.shared.debug("Memory pressure \(level.rawValue) handled by \(targets.count) participants")
+    }
+}
+
+// MARK: - URLCache Trimming
+extension URLCache {
+    /// Evicts roughly `fraction` of the in-memory responses by briefly lowering the capacity.
+    /// The on-disk store is left alone since it does not count against the memory footprint.
+    func trimMemory(fraction: Double) {
+        let capacity = memoryCapacity
+        memoryCapacity = Int(Double(currentMemoryUsage) * max(0, 1 - fraction))
+        memoryCapacity = capacity
+    }
+}
+
+/// Trims `URLCache.shared`, which is not owned by any one module
+private final class SharedURLCacheParticipant: MemoryPressureParticipant {
+    func trimMemory(fraction: Double, level: MemoryPressureLevel) {
+        URLCache.shared.trimMemory(fraction: fraction)
+    }
+}
@@ -0,0 +1,64 @@
+//
+// PerformanceActivity.swift
+// FantasyGMAssistant
+//
+// App-wide tracking of work that warrants dense performance sampling
+// Version: 1.0.0
+//
+
+import Foundation // iOS 14.0+
+
+// MARK: - Activity Kinds
+@objc public enum PerformanceActivityKind: Int {
+    case simulation = 0
+    case videoRender = 1
+}
+
+// MARK: - Performance Activity
+/// Counts running simulations and video renders. PerformanceOptimizer samples densely while
+/// any is running and sparsely otherwise, so idle monitoring costs almost nothing.
+@objc public final class PerformanceActivity: NSObject {
+    @objc public static let shared = PerformanceActivity()
+    /// Posted when the first activity begins or the last one ends
+    public static let didChangeNotification = Notification.Name("PerformanceActivityDidChange")
+    
+    private let lock = NSLock()
+    private var running: [PerformanceActivityKind: Int] = [:]
+    
+    private override init() {
+        super.init()
+    }
+    
+    @objc public var isActive: Bool {
+        lock.lock()
+        defer { lock.unlock() }
+        return !running.isEmpty
+    }
+    
+    @objc public func begin(_ kind: PerformanceActivityKind) {
+        lock.lock()
+        let wasActive = !running.isEmpty
+        running[kind, default: 0] += 1
+        lock.unlock()
+        
+        if !wasActive {
+            NotificationCenter.default.post(name: Self.didChangeNotification, object: self)
+        }
+    }
+    
+    /// Unbalanced calls are ignored
+    @objc public func end(_ kind: PerformanceActivityKind) {
+        lock.lock()
+        guard let count = running[kind] else {
+            lock.unlock()
+            return
+        }
+        running[kind] = count > 1 ? count - 1 : nil
+        let isIdle = running.isEmpty
+        lock.unlock()
+        
+        if isIdle {
+            NotificationCenter.default.post(name: Self.didChangeNotification, object: self)
+        }
+    }
+}
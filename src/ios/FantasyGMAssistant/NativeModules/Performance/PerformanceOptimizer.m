@@ -11,6 +11,7 @@
 #import <React/RCTLog.h> // React Native 0.72+
 #import <DatadogObjc/DatadogObjc.h> // DataDog 1.0+
 #import <Foundation/Foundation.h> // iOS 14.0+
+#import "FantasyGMAssistant-Swift.h" // Bridge header for Swift
 
 @interface PerformanceOptimizer () <RCTBridgeModule>
 
@@ -51,7 +52,7 @@ RCT_EXPORT_MODULE();
 - (void)handleMemoryWarning {
     [self.lock lock];
     @try {
-        [self optimizeMemoryUsage];
+        // MemoryPressureCoordinator observes this notification itself and does the trimming
         [self.metricsLogger logMetric:@"memory_warning"
                               value:@1
                               tags:@{@"type": @"system"}];
@@ -148,18 +149,11 @@ RCT_EXPORT_METHOD(optimizeMemoryUsage) {
         float currentMemoryUsage = [self getMemoryUsage];
         
         if (currentMemoryUsage > 0.8) { // 80% threshold
-            // Clear image caches
-            [[NSURLCache sharedURLCache] removeAllCachedResponses];
+            // Trim registered caches coldest-first instead of wiping the URL cache outright
+            [[MemoryPressureCoordinator shared] trimFor:MemoryPressureLevelWarning];
             
-            // Clear temporary files
-            NSString *tempDir = NSTemporaryDirectory();
-            NSFileManager *fileManager = [NSFileManager defaultManager];
-            NSArray *tempFiles = [fileManager contentsOfDirectoryAtPath:tempDir error:nil];
-            
-            for (NSString *file in tempFiles) {
-                NSString *filePath = [tempDir stringByAppendingPathComponent:file];
-                [fileManager removeItemAtPath:filePath error:nil];
-            }
+            // Temporary files are left to the operations that own them; sweeping the directory
+            // here would delete FFmpeg inputs and outputs still in use
             
             // Log optimization event
             [self.metricsLogger logMetric:@"memory_optimized"
@@ -13,9 +13,13 @@ import os.log // iOS 14.0+
 
 // MARK: - Constants
 private let MEMORY_WARNING_THRESHOLD: Float = 0.8
+/// Sampling interval while idle
 private let METRICS_COLLECTION_INTERVAL: TimeInterval = 30.0
+/// Sampling interval while a simulation or video render is running
+private let ACTIVE_METRICS_COLLECTION_INTERVAL: TimeInterval = 1.0
 private let AI_RECOMMENDATION_TIMEOUT: TimeInterval = 2.0
 private let MAX_METRIC_ENTRIES: Int = 1000
+private let AI_RECOMMENDATION_OPERATION = "ai_recommendation"
 
 // MARK: - MetricType Enumeration
 private enum MetricType: String {
@@ -35,8 +39,13 @@ final class PerformanceOptimizer: NSObject, MXMetricManagerSubscriber {
     private let metricsCollector: MXMetricManager
     private var lastMemoryWarning: Date?
     private var deviceCapabilities: [String: Any] = [:]
-    private var metricStorage: [[String: Any]] = []
-    private var aiRecommendationTimings: [TimeInterval] = []
+    /// Samples are only touched on `metricQueue`
+    private let sampleBuffer = PerformanceSampleBuffer(capacity: MAX_METRIC_ENTRIES)
+    private let usageSampler = ProcessUsageSampler()
+    private var samplingTimer: DispatchSourceTimer?
+    private let frameTracker = FrameHitchTracker()
+    /// Latency sketches by operation type, only touched on `metricQueue`
+    private var latencySketches: [String: LatencySketch] = [:]
     private let metricQueue = DispatchQueue(label: "com.fantasygm.metrics", qos: .utility)
     private let memoryWarningThreshold: Float
     
@@ -60,23 +69,24 @@ final class PerformanceOptimizer: NSObject, MXMetricManagerSubscriber {
             name: UIApplication.didReceiveMemoryWarningNotification,
             object: nil
         )
+        
+        NotificationCenter.default.addObserver(
+            self,
+            selector: #selector(handleActivityChange),
+            name: PerformanceActivity.didChangeNotification,
+            object: nil
+        )
     }
     
     // MARK: - Private Methods
     private func configureDeviceCapabilities() {
-        deviceCapabilities = [
-            "processorCount": ProcessInfo.processInfo.processorCount,
-            "physicalMemory": ProcessInfo.processInfo.physicalMemory,
-            "thermalState": ProcessInfo.processInfo.thermalState.rawValue,
-            "isLowPowerModeEnabled": ProcessInfo.processInfo.isLowPowerModeEnabled,
-            "systemVersion": UIDevice.current.systemVersion
-        ]
+        deviceCapabilities = DeviceCapabilities.current().dictionaryRepresentation
     }
     
     @objc private func handleMemoryWarning() {
+        // Trimming is coordinated by MemoryPressureCoordinator; this only records the event
         metricQueue.async {
             self.lastMemoryWarning = Date()
-            self.optimizeMemoryUsage()
             
             Logger.shared.error(
                 "Memory warning received",
@@ -88,97 +98,89 @@ final class PerformanceOptimizer: NSObject, MXMetricManagerSubscriber {
         }
     }
     
-    private func collectMetrics() -> [String: Any] {
-        var metrics: [String: Any] = [:]
-        
-        let memoryUsage = getMemoryUsage()
-        let cpuUsage = getCPUUsage()
-        
-        metrics = [
-            "timestamp": Date().timeIntervalSince1970,
-            MetricType.memory.rawValue: memoryUsage,
-            MetricType.cpu.rawValue: cpuUsage,
-            MetricType.frameRate.rawValue: getFrameRate(),
-            "device_capabilities": deviceCapabilities,
-            "low_power_mode": ProcessInfo.processInfo.isLowPowerModeEnabled,
-            "thermal_state": ProcessInfo.processInfo.thermalState.rawValue
-        ]
-        
-        if !aiRecommendationTimings.isEmpty {
-            metrics[MetricType.aiRecommendation.rawValue] = calculateAIMetrics()
+    @objc private func handleActivityChange() {
+        metricQueue.async {
+            guard self.isMonitoring else { return }
+            self.scheduleSampling()
         }
-        
-        return metrics
     }
     
-    private func getMemoryUsage() -> Float {
-        var info = mach_task_basic_info()
-        var count = mach_msg_type_number_t(MemoryLayout<mach_task_basic_info>.size)/4
+    /// Must run on `metricQueue`. Restarts the timer at the interval the current activity calls for.
+    private func scheduleSampling() {
+        let interval = PerformanceActivity.shared.isActive
+            ? ACTIVE_METRICS_COLLECTION_INTERVAL
+            : METRICS_COLLECTION_INTERVAL
         
-        let kerr: kern_return_t = withUnsafeMutablePointer(to: &info) {
-            $0.withMemoryRebound(to: integer_t.self, capacity: 1) {
-                task_info(mach_task_self_,
-                         task_flavor_t(MACH_TASK_BASIC_INFO),
-                         $0,
-                         &count)
-            }
+        samplingTimer?.cancel()
+        let timer = DispatchSource.makeTimerSource(queue: metricQueue)
+        // Generous leeway lets the system coalesce idle wakeups with other work
+        timer.schedule(deadline: .now() + interval, repeating: interval, leeway: .milliseconds(Int(interval * 100)))
+        timer.setEventHandler { [weak self] in
+            guard let self = self else { return }
+            self.sampleBuffer.append(self.takeSample())
         }
-        
-        if kerr == KERN_SUCCESS {
-            return Float(info.resident_size) / Float(ProcessInfo.processInfo.physicalMemory)
-        }
-        
-        return 0.0
+        timer.resume()
+        samplingTimer = timer
     }
     
-    private func getCPUUsage() -> Float {
-        var totalUsagePercent: Float = 0.0
-        var threadList: thread_act_array_t?
-        var threadCount: mach_msg_type_number_t = 0
-        
-        let threadResult = task_threads(mach_task_self_, &threadList, &threadCount)
+    /// Must run on `metricQueue`. Also republishes the performance profile, which catches any
+    /// thermal or power change whose notification was missed.
+    private func takeSample() -> PerformanceSample {
+        PerformanceProfileMonitor.shared.refresh()
+        return PerformanceSample(timestamp: Date().timeIntervalSince1970,
+                                 memoryUsage: getMemoryUsage(),
+                                 cpuUsage: usageSampler.cpuUsage(),
+                                 frameRate: getFrameRate(),
+                                 thermalState: UInt8(ProcessInfo.processInfo.thermalState.rawValue))
+    }
+    
+    private func collectMetrics() -> [String: Any] {
+        let sample = takeSample()
+        var metrics: [String: Any] = [
+            "timestamp": sample.timestamp,
+            MetricType.memory.rawValue: sample.memoryUsage,
+            MetricType.cpu.rawValue: sample.cpuUsage,
+            MetricType.frameRate.rawValue: sample.frameRate,
+            "device_capabilities": deviceCapabilities,
+            "low_power_mode": ProcessInfo.processInfo.isLowPowerModeEnabled,
+            "thermal_state": Int(sample.thermalState),
+            "sample_count": sampleBuffer.count,
+            "frame_pacing": frameTracker.dictionaryRepresentation,
+            "performance_profile": PerformanceProfileMonitor.shared.current.dictionaryRepresentation
+        ]
         
-        if threadResult == KERN_SUCCESS, let threadList = threadList {
-            for i in 0..<Int(threadCount) {
-                var threadInfo = thread_basic_info()
-                var count = mach_msg_type_number_t(THREAD_BASIC_INFO_COUNT)
-                
-                let infoResult = withUnsafeMutablePointer(to: &threadInfo) {
-                    $0.withMemoryRebound(to: integer_t.self, capacity: 1) {
-                        thread_info(threadList[i],
-                                  thread_flavor_t(THREAD_BASIC_INFO),
-                                  $0,
-                                  &count)
-                    }
-                }
-                
-                if infoResult == KERN_SUCCESS {
-                    totalUsagePercent += Float(threadInfo.cpu_usage) / Float(TH_USAGE_SCALE)
-                }
+        if let aiSketch = latencySketches[AI_RECOMMENDATION_OPERATION] {
+            metrics[MetricType.aiRecommendation.rawValue] = latencySummary(aiSketch)
+        }
+        if !latencySketches.isEmpty {
+            metrics["operation_latency"] = latencySketches.mapValues { sketch -> [String: Any] in
+                var summary = latencySummary(sketch)
+                summary["sketch"] = sketch.dictionaryRepresentation
+                return summary
             }
-            
-            vm_deallocate(mach_task_self_,
-                         vm_address_t(UInt(bitPattern: threadList)),
-                         vm_size_t(Int(threadCount) * MemoryLayout<thread_t>.stride))
         }
         
-        return min(totalUsagePercent * 100, 100.0)
+        return metrics
     }
     
+    private func getMemoryUsage() -> Float {
+        return ProcessUsageSampler.memoryUsage()
+    }
+    
+    /// Delivered frame rate; 0 until the frame tracker has measured a frame
     private func getFrameRate() -> Float {
-        return Float(UIScreen.main.maximumFramesPerSecond)
+        return frameTracker.frameRate ?? 0
     }
     
-    private func calculateAIMetrics() -> [String: Any] {
-        let sortedTimings = aiRecommendationTimings.sorted()
-        let count = sortedTimings.count
-        
+    /// Reads quantiles straight from the sketch, so the cost does not grow with the number of timings
+    private func latencySummary(_ sketch: LatencySketch) -> [String: Any] {
         return [
-            "average": sortedTimings.reduce(0, +) / Double(count),
-            "median": count % 2 == 0 ? (sortedTimings[count/2] + sortedTimings[count/2-1])/2 : sortedTimings[count/2],
-            "p95": sortedTimings[Int(Double(count) * 0.95)],
-            "max": sortedTimings.last ?? 0,
-            "count": count
+            "average": sketch.average,
+            "median": sketch.quantile(0.5) ?? 0,
+            "p95": sketch.quantile(0.95) ?? 0,
+            "p99": sketch.quantile(0.99) ?? 0,
+            "max": sketch.isEmpty ? 0 : sketch.max,
+            "count": sketch.count
         ]
     }
     
@@ -195,24 +197,36 @@ final class PerformanceOptimizer: NSObject, MXMetricManagerSubscriber {
             self.isMonitoring = true
             self.metricsCollector.add(self)
             
-            // Start periodic collection
-            Timer.scheduledTimer(withTimeInterval: METRICS_COLLECTION_INTERVAL, repeats: true) { [weak self] _ in
-                self?.metricQueue.async {
-                    guard let metrics = self?.collectMetrics() else { return }
-                    self?.metricStorage.append(metrics)
-                    
-                    // Rotate storage if needed
-                    if self?.metricStorage.count ?? 0 > MAX_METRIC_ENTRIES {
-                        self?.metricStorage.removeFirst()
-                    }
-                }
-            }
+            // Dense while simulations or renders run, sparse otherwise
+            self.scheduleSampling()
+            self.frameTracker.start()
             
             Logger.shared.debug("Performance monitoring started")
             resolve(nil)
         }
     }
     
+    /// Stops sampling and the display link; samples and latency sketches are kept for export
+    @objc(stopPerformanceMonitoring:withRejecter:)
+    func stopPerformanceMonitoring(_ resolve: @escaping RCTPromiseResolveBlock,
+                                   rejecter reject: @escaping RCTPromiseRejectBlock) {
+        metricQueue.async {
+            guard self.isMonitoring else {
+                resolve(nil)
+                return
+            }
+            
+            self.isMonitoring = false
+            self.metricsCollector.remove(self)
+            self.samplingTimer?.cancel()
+            self.samplingTimer = nil
+            self.frameTracker.stop()
+            
+            Logger.shared.debug("Performance monitoring stopped")
+            resolve(nil)
+        }
+    }
+    
     @objc(getPerformanceMetrics:withRejecter:)
     func getPerformanceMetrics(_ resolve: @escaping RCTPromiseResolveBlock,
                              rejecter reject: @escaping RCTPromiseRejectBlock) {
@@ -222,32 +236,81 @@ final class PerformanceOptimizer: NSObject, MXMetricManagerSubscriber {
         }
     }
     
+    /// Sends the whole sample window in one call as base64 of `PerformanceSampleBuffer.exportBinary()`
+    @objc(exportPerformanceSamples:withRejecter:)
+    func exportPerformanceSamples(_ resolve: @escaping RCTPromiseResolveBlock,
+                                  rejecter reject: @escaping RCTPromiseRejectBlock) {
+        metricQueue.async {
+            resolve([
+                "count": self.sampleBuffer.count,
+                "data": self.sampleBuffer.exportBinary().base64EncodedString()
+            ])
+        }
+    }
+    
+    /// Records how long one operation took, in seconds, e.g. "ai_recommendation"
+    @objc(recordOperationTiming:duration:)
+    func recordOperationTiming(_ operation: String, duration: TimeInterval) {
+        metricQueue.async {
+            self.latencySketches[operation, default: LatencySketch()].record(duration)
+        }
+    }
+    
+    /// Attributes frame hitches to the React Native screen now showing; nil when none
+    @objc(setActiveScreen:)
+    func setActiveScreen(_ name: String?) {
+        frameTracker.setActiveScreen(name)
+    }
+    
+    /// Attributes frame hitches to a named span such as "run_simulation" until it ends
+    @objc(beginFrameSpan:)
+    func beginFrameSpan(_ name: String) {
+        frameTracker.beginSpan(name)
+    }
+    
+    @objc(endFrameSpan:)
+    func endFrameSpan(_ name: String) {
+        frameTracker.endSpan(name)
+    }
+    
+    /// Opens a span around JavaScript work and resolves with its ID; 0 as `parentID` means none
+    @objc(beginTraceSpan:parentID:resolve:withRejecter:)
+    func beginTraceSpan(_ name: String,
+                        parentID: Double,
+                        resolve: @escaping RCTPromiseResolveBlock,
+                        rejecter reject: @escaping RCTPromiseRejectBlock) {
+        let parent = parentID > 0 ? UInt64(parentID) : nil
+        resolve(NSNumber(value: PerformanceTracer.shared.beginBridgeSpan(name, parentID: parent)))
+    }
+    
+    @objc(endTraceSpan:failed:)
+    func endTraceSpan(_ spanID: Double, failed: Bool) {
+        guard spanID > 0, PerformanceTracer.shared.endBridgeSpan(UInt64(spanID), failed: failed) else {
+            Logger.shared.debug("Ignored end of unknown trace span \(spanID)")
+            return
+        }
+    }
+    
+    /// Lets JavaScript mark simulations so they are sampled densely; calls must be balanced
+    @objc(beginSimulationActivity)
+    func beginSimulationActivity() {
+        PerformanceActivity.shared.begin(.simulation)
+    }
+    
+    @objc(endSimulationActivity)
+    func endSimulationActivity() {
+        PerformanceActivity.shared.end(.simulation)
+    }
+    
     @objc(optimizeMemoryUsage)
     func optimizeMemoryUsage() {
         let currentMemoryUsage = getMemoryUsage()
         
         if currentMemoryUsage > memoryWarningThreshold {
-            // Clear image caches
-            URLCache.shared.removeAllCachedResponses()
-            
-            // Clear temporary files
-            let tmpDirectory = NSTemporaryDirectory()
-            let fileManager = FileManager.default
-            
-            do {
-                let tmpFiles = try fileManager.contentsOfDirectory(atPath: tmpDirectory)
-                try tmpFiles.forEach { file in
-                    let path = (tmpDirectory as NSString).appendingPathComponent(file)
-                    try fileManager.removeItem(atPath: path)
-                }
-            } catch {
-                Logger.shared.error("Failed to clear temporary files", error: error)
-            }
-            
-            // Force garbage collection
-            autoreleasepool { }
+            // Trim registered caches coldest-first rather than wiping them and the temp directory
+            MemoryPressureCoordinator.shared.trim(for: .warning)
             
-            Logger.shared.debug("Memory optimization completed")
+            Logger.shared.debug("Memory optimization requested")
         }
     }
     
@@ -44,6 +44,63 @@ RCT_EXTERN_METHOD(getPerformanceMetrics:(RCTPromiseResolveBlock)resolve
  */
 RCT_EXTERN_METHOD(optimizeMemoryUsage)
 
+/**
+ * Records the duration of one operation, in seconds, into its latency sketch.
+ * Percentiles appear in getPerformanceMetrics under operation_latency.
+ */
+RCT_EXTERN_METHOD(recordOperationTiming:(NSString *)operation
+                  duration:(double)duration)
+
+/**
+ * Exports the retained sample window as base64 binary in a single call.
+ * Resolves with the sample count and the encoded columns.
+ */
+RCT_EXTERN_METHOD(exportPerformanceSamples:(RCTPromiseResolveBlock)resolve
+                  withRejecter:(RCTPromiseRejectBlock)reject)
+
+/**
+ * Sets the screen that frame hitches are attributed to.
+ * Pass null when no screen is showing.
+ */
+RCT_EXTERN_METHOD(setActiveScreen:(nullable NSString *)name)
+
+/**
+ * Starts a named span that frame hitches are attributed to.
+ * Every begin must be balanced by an end with the same name.
+ */
+RCT_EXTERN_METHOD(beginFrameSpan:(NSString *)name)
+
+/**
+ * Ends the most recent span with this name.
+ */
+RCT_EXTERN_METHOD(endFrameSpan:(NSString *)name)
+
+/**
+ * Opens a tracing span around JavaScript work, shown in Instruments and batched to DataDog.
+ * Resolves with the span ID; pass 0 as parentID for a top-level span.
+ */
+RCT_EXTERN_METHOD(beginTraceSpan:(NSString *)name
+                  parentID:(double)parentID
+                  resolve:(RCTPromiseResolveBlock)resolve
+                  withRejecter:(RCTPromiseRejectBlock)reject)
+
+/**
+ * Closes a span opened with beginTraceSpan.
+ */
+RCT_EXTERN_METHOD(endTraceSpan:(double)spanID
+                  failed:(BOOL)failed)
+
+/**
+ * Marks a simulation as running so samples are taken densely.
+ * Every begin must be balanced by an end.
+ */
+RCT_EXTERN_METHOD(beginSimulationActivity)
+
+/**
+ * Marks a simulation as finished.
+ */
+RCT_EXTERN_METHOD(endSimulationActivity)
+
 @end
 
 NS_ASSUME_NONNULL_END
\ No newline at end of file
@@ -0,0 +1,150 @@
+//
+// PerformanceProfile.swift
+// FantasyGMAssistant
+//
+// Published device tier and live thermal and power state that modules scale their work to
+// Version: 1.0.0
+//
+
+import Foundation // iOS 14.0+
+
+// MARK: - Performance Level
+/// How much work modules should take on right now, from the device tier lowered by live conditions
+public enum PerformanceLevel: Int, Comparable {
+    case minimal = 0
+    case reduced = 1
+    case full = 2
+    
+    public static func < (lhs: PerformanceLevel, rhs: PerformanceLevel) -> Bool {
+        return lhs.rawValue < rhs.rawValue
+    }
+}
+
+// MARK: - Performance Profile
+public struct PerformanceProfile: Equatable {
+    public let deviceClass: DeviceClass
+    public let thermalState: ProcessInfo.ThermalState
+    public let isLowPowerModeEnabled: Bool
+    
+    public init(deviceClass: DeviceClass, thermalState: ProcessInfo.ThermalState, isLowPowerModeEnabled: Bool) {
+        self.deviceClass = deviceClass
+        self.thermalState = thermalState
+        self.isLowPowerModeEnabled = isLowPowerModeEnabled
+    }
+    
+    public init(capabilities: DeviceCapabilities) {
+        self.init(deviceClass: capabilities.deviceClass,
+                  thermalState: capabilities.thermalState,
+                  isLowPowerModeEnabled: capabilities.isLowPowerModeEnabled)
+    }
+    
+    /// No thermal headroom, or the user asked the system to save power
+    public var isConstrained: Bool {
+        return thermalState == .serious || thermalState == .critical || isLowPowerModeEnabled
+    }
+    
+    /// One level below the device tier while constrained, and minimal once the device is critical
+    public var level: PerformanceLevel {
+        guard thermalState != .critical else { return .minimal }
+        
+        let base: PerformanceLevel
+        switch deviceClass {
+        case .high: base = .full
+        case .mid: base = .reduced
+        case .low: base = .minimal
+        }
+        return isConstrained ? PerformanceLevel(rawValue: max(0, base.rawValue - 1)) ?? .minimal : base
+    }
+    
+    var dictionaryRepresentation: [String: Any] {
+        return [
+            "level": level.rawValue,
+            "deviceClass": deviceClass.rawValue,
+            "thermalState": thermalState.rawValue,
+            "isLowPowerModeEnabled": isLowPowerModeEnabled
+        ]
+    }
+}
+
+// MARK: - Observer Protocol
+public protocol PerformanceProfileObserver: AnyObject {
+    /// Called off the main thread with the current profile on registration and after every change
+    func performanceProfileDidChange(_ profile: PerformanceProfile)
+}
+
+// MARK: - Performance Profile Monitor
+/// Publishes the performance profile to registered modules. Thermal and Low Power Mode changes
+/// are picked up from system notifications and on every PerformanceOptimizer sample.
+public final class PerformanceProfileMonitor {
+    public static let shared = PerformanceProfileMonitor(deviceClass: DeviceCapabilities.current().deviceClass)
+    
+    private struct Registration {
+        weak var observer: PerformanceProfileObserver?
+    }
+    
+    private let queue = DispatchQueue(label: "com.fantasygm.performanceprofile", qos: .utility)
+    private let lock = NSLock()
+    private let deviceClass: DeviceClass
+    private var profile: PerformanceProfile
+    private var registrations: [Registration] = []
+    
+    init(deviceClass: DeviceClass) {
+        self.deviceClass = deviceClass
+        let processInfo = ProcessInfo.processInfo
+        profile = PerformanceProfile(deviceClass: deviceClass,
+                                     thermalState: processInfo.thermalState,
+                                     isLowPowerModeEnabled: processInfo.isLowPowerModeEnabled)
+        
+        let names = [ProcessInfo.thermalStateDidChangeNotification, Notification.Name.NSProcessInfoPowerStateDidChange]
+        for name in names {
+            NotificationCenter.default.addObserver(forName: name, object: nil, queue: nil) { [weak self] _ in
+                self?.refresh()
+            }
+        }
+    }
+    
+    public var current: PerformanceProfile {
+        lock.lock()
+        defer { lock.unlock() }
+        return profile
+    }
+    
+    /// Observers are held weakly and told the current profile straight away
+    public func register(_ observer: PerformanceProfileObserver) {
+        lock.lock()
+        registrations.removeAll { $0.observer == nil }
+        registrations.append(Registration(observer: observer))
+        let profile = self.profile
+        lock.unlock()
+        
+        queue.async {
+            observer.performanceProfileDidChange(profile)
+        }
+    }
+    
+    /// Re-reads thermal and power state; cheap enough to call on every sample
+    public func refresh() {
+        let processInfo = ProcessInfo.processInfo
+        publish(PerformanceProfile(deviceClass: deviceClass,
+                                   thermalState: processInfo.thermalState,
+                                   isLowPowerModeEnabled: processInfo.isLowPowerModeEnabled))
+    }
+    
+    /// Notifies every observer if `profile` differs from the current one
+    func publish(_ profile: PerformanceProfile) {
+        lock.lock()
+        guard profile != self.profile else {
+            lock.unlock()
+            return
+        }
+        self.profile = profile
+        registrations.removeAll { $0.observer == nil }
+        let observers = registrations.compactMap { $0.observer }
+        lock.unlock()
+        
+        Logger.shared.debug("Performance profile changed to level \(profile.level.rawValue)")
+        queue.async {
+            observers.forEach { $0.performanceProfileDidChange(profile) }
+        }
+    }
+}
@@ -0,0 +1,116 @@
+//
+// PerformanceSampleBuffer.swift
+// FantasyGMAssistant
+//
+// Fixed-capacity struct-of-arrays ring buffer of performance samples with a binary export
+// Version: 1.0.0
+//
+
+import Foundation // iOS 14.0+
+
+// MARK: - Export Constants
+/// "FGPS" read as a little-endian UInt32
+private let SAMPLE_EXPORT_MAGIC: UInt32 = 0x5350_4746
+private let SAMPLE_EXPORT_VERSION: UInt32 = 1
+private let SAMPLE_EXPORT_COLUMN_COUNT: UInt32 = 5
+
+// MARK: - Performance Sample
+public struct PerformanceSample: Equatable {
+    /// Seconds since 1970
+    public let timestamp: TimeInterval
+    /// Resident memory as a share of physical memory
+    public let memoryUsage: Float
+    /// Percent of one core, capped at 100
+    public let cpuUsage: Float
+    public let frameRate: Float
+    /// `ProcessInfo.ThermalState` raw value
+    public let thermalState: UInt8
+}
+
+// MARK: - Sample Buffer
+/// Keeps the newest `capacity` samples in preallocated columns, so appending never allocates and
+/// overwriting the oldest sample is O(1). Not thread-safe; the owner serializes access.
+final class PerformanceSampleBuffer {
+    let capacity: Int
+    private(set) var count = 0
+    
+    private var timestamps: [Double]
+    private var memoryUsage: [Float]
+    private var cpuUsage: [Float]
+    private var frameRates: [Float]
+    private var thermalStates: [UInt8]
+    /// Slot the next sample is written to
+    private var head = 0
+    
+    init(capacity: Int) {
+        self.capacity = max(1, capacity)
+        timestamps = [Double](repeating: 0, count: self.capacity)
+        memoryUsage = [Float](repeating: 0, count: self.capacity)
+        cpuUsage = [Float](repeating: 0, count: self.capacity)
+        frameRates = [Float](repeating: 0, count: self.capacity)
+        thermalStates = [UInt8](repeating: 0, count: self.capacity)
+    }
+    
+    func append(_ sample: PerformanceSample) {
+        timestamps[head] = sample.timestamp
+        memoryUsage[head] = sample.memoryUsage
+        cpuUsage[head] = sample.cpuUsage
+        frameRates[head] = sample.frameRate
+        thermalStates[head] = sample.thermalState
+        
+        head = (head + 1) % capacity
+        count = min(count + 1, capacity)
+    }
+    
+    /// Samples in recording order; 0 is the oldest retained
+    subscript(index: Int) -> PerformanceSample {
+        precondition(index >= 0 && index < count, "Sample index out of range")
+        let slot = (oldestSlot + index) % capacity
+        return PerformanceSample(timestamp: timestamps[slot],
+                                 memoryUsage: memoryUsage[slot],
+                                 cpuUsage: cpuUsage[slot],
+                                 frameRate: frameRates[slot],
+                                 thermalState: thermalStates[slot])
+    }
+    
+    var latest: PerformanceSample? {
+        return count > 0 ? self[count - 1] : nil
+    }
+    
+    func removeAll() {
+        head = 0
+        count = 0
+    }
+    
+    // MARK: - Binary Export
+    /// Little-endian, oldest sample first, one column after another so JavaScript can view each
+    /// column as a typed array without copying:
+    /// a 16-byte header (magic, version, count, column count as UInt32), then `count` Float64
+    /// timestamps, Float32 memory, CPU and frame rate columns, and UInt8 thermal states.
+    func exportBinary() -> Data {
+        var data = Data(capacity: 16 + count * 21)
+        for field in [SAMPLE_EXPORT_MAGIC, SAMPLE_EXPORT_VERSION, UInt32(count), SAMPLE_EXPORT_COLUMN_COUNT] {
+            withUnsafeBytes(of: field.littleEndian) { data.append(contentsOf: $0) }
+        }
+        
+        appendColumn(timestamps, to: &data)
+        appendColumn(memoryUsage, to: &data)
+        appendColumn(cpuUsage, to: &data)
+        appendColumn(frameRates, to: &data)
+        appendColumn(thermalStates, to: &data)
+        return data
+    }
+    
+    // MARK: - Private Methods
+    private var oldestSlot: Int {
+        return (head - count + capacity) % capacity
+    }
+    
+    /// Copies the retained part of a column in order, which wraps at most once
+    private func appendColumn<T>(_ column: [T], to data: inout Data) {
+        let start = oldestSlot
+        let firstRun = min(count, capacity - start)
+        column[start..<(start + firstRun)].withUnsafeBytes { data.append(contentsOf: $0) }
+        column[0..<(count - firstRun)].withUnsafeBytes { data.append(contentsOf: $0) }
+    }
+}
@@ -0,0 +1,233 @@
+//
+// PerformanceTracer.swift
+// FantasyGMAssistant
+//
+// Nested timing spans shown in Instruments via os_signpost and batched to DataDog
+// Version: 1.0.0
+//
+
+import Foundation // iOS 14.0+
+import UIKit // iOS 14.0+
+import os.signpost // iOS 14.0+
+
+// MARK: - Tracer Constants
+private let TRACE_SUBSYSTEM = "com.fantasygm.assistant"
+/// Finished spans kept while waiting to be exported; further spans are counted and dropped
+private let TRACE_BUFFER_CAPACITY = 512
+private let TRACE_EXPORT_BATCH_SIZE = 100
+private let TRACE_EXPORT_INTERVAL: TimeInterval = 60
+private let TRACE_EVENT_NAME = "performance_trace"
+
+// MARK: - Trace Span
+/// An open span. Pass it to `end`, or as `parent` to spans started from callbacks.
+public struct TraceSpan {
+    public let id: UInt64
+    public let parentID: UInt64?
+    public let name: String
+    fileprivate let signpostName: StaticString
+    fileprivate let start: TimeInterval
+}
+
+/// A finished span; times are seconds of system uptime
+public struct TraceSpanRecord {
+    public let id: UInt64
+    public let parentID: UInt64?
+    public let name: String
+    public let start: TimeInterval
+    public let duration: TimeInterval
+    public let failed: Bool
+    
+    var dictionaryRepresentation: [String: Any] {
+        var representation: [String: Any] = [
+            "id": id,
+            "name": name,
+            "start": start,
+            "duration_ms": duration * 1000,
+            "failed": failed
+        ]
+        representation["parent_id"] = parentID
+        return representation
+    }
+}
+
+// MARK: - Performance Tracer
+/// Lightweight spans for native hot paths. Each span is an os_signpost interval, so nesting shows
+/// in Instruments under the Points of Interest, and a record buffered in memory that is exported
+/// through AnalyticsManager in batches. Async work started inside `trace` is parented to it
+/// automatically; callback-based code passes `parent` explicitly.
+public final class PerformanceTracer {
+    public static let shared = PerformanceTracer(
+        log: OSLog(subsystem: TRACE_SUBSYSTEM, category: .pointsOfInterest),
+        exporter: { AnalyticsManager.shared.trackEvent(TRACE_EVENT_NAME, parameters: $0) }
+    )
+    
+    /// Innermost span of the current task
+    @TaskLocal static var currentSpanID: UInt64?
+    
+    private let log: OSLog
+    private let exporter: ([String: Any]) -> Void
+    private let lock = NSLock()
+    private var nextID: UInt64 = 1
+    private var finished: [TraceSpanRecord] = []
+    private var droppedCount = 0
+    private var lastExport = ProcessInfo.processInfo.systemUptime
+    /// Spans opened over the bridge, which JavaScript closes by ID
+    private var bridgeSpans: [UInt64: TraceSpan] = [:]
+    private var backgroundObserver: NSObjectProtocol?
+    
+    init(log: OSLog, exporter: @escaping ([String: Any]) -> Void) {
+        self.log = log
+        self.exporter = exporter
+        finished.reserveCapacity(TRACE_BUFFER_CAPACITY)
+        
+        // Spans still waiting for a full batch or the export interval would be lost if the app is
+        // then terminated
+        backgroundObserver = NotificationCenter.default.addObserver(
+            forName: UIApplication.didEnterBackgroundNotification,
+            object: nil,
+            queue: nil
+        ) { [weak self] _ in
+            self?.flush()
+        }
+    }
+    
+    deinit {
+        if let backgroundObserver = backgroundObserver {
+            NotificationCenter.default.removeObserver(backgroundObserver)
+        }
+    }
+    
+    // MARK: - Spans
+    /// Without `parent` the span nests under the current task's innermost `trace` span, if any
+    public func begin(_ name: StaticString, detail: String? = nil, parent: TraceSpan? = nil) -> TraceSpan {
+        return begin(signpostName: name, name: "\(name)", detail: detail, parentID: parent?.id ?? Self.currentSpanID)
+    }
+    
+    public func end(_ span: TraceSpan, failed: Bool = false) {
+        let now = ProcessInfo.processInfo.systemUptime
+        os_signpost(.end, log: log, name: span.signpostName, signpostID: OSSignpostID(span.id),
+                    "%{public}s", failed ? "failed" : "ok")
+        
+        let record = TraceSpanRecord(id: span.id, parentID: span.parentID, name: span.name,
+                                     start: span.start, duration: now - span.start, failed: failed)
+        lock.lock()
+        if finished.count < TRACE_BUFFER_CAPACITY {
+            finished.append(record)
+        } else {
+            droppedCount += 1
+        }
+        let batch = takeBatchIfDue(at: now)
+        lock.unlock()
+        
+        if let batch = batch {
+            exporter(batch)
+        }
+    }
+    
+    /// Times `work`, marking the span failed if it throws. Spans begun inside nest under it.
+    public func trace<T>(_ name: StaticString,
+                         detail: String? = nil,
+                         parent: TraceSpan? = nil,
+                         _ work: () throws -> T) rethrows -> T {
+        let span = begin(name, detail: detail, parent: parent)
+        do {
+            let result = try Self.$currentSpanID.withValue(span.id) { try work() }
+            end(span)
+            return result
+        } catch {
+            end(span, failed: true)
+            throw error
+        }
+    }
+    
+    public func trace<T>(_ name: StaticString,
+                         detail: String? = nil,
+                         parent: TraceSpan? = nil,
+                         _ work: () async throws -> T) async rethrows -> T {
+        let span = begin(name, detail: detail, parent: parent)
+        do {
+            let result = try await Self.$currentSpanID.withValue(span.id) { try await work() }
+            end(span)
+            return result
+        } catch {
+            end(span, failed: true)
+            throw error
+        }
+    }
+    
+    // MARK: - Bridge Spans
+    /// Spans around JavaScript work share one signpost name, with the JavaScript name as detail
+    func beginBridgeSpan(_ name: String, parentID: UInt64?) -> UInt64 {
+        let span = begin(signpostName: "js", name: name, detail: name, parentID: parentID)
+        lock.lock()
+        bridgeSpans[span.id] = span
+        lock.unlock()
+        return span.id
+    }
+    
+    /// Returns false when no bridge span with that ID is open
+    @discardableResult
+    func endBridgeSpan(_ id: UInt64, failed: Bool) -> Bool {
+        lock.lock()
+        let span = bridgeSpans.removeValue(forKey: id)
+        lock.unlock()
+        
+        guard let span = span else { return false }
+        end(span, failed: failed)
+        return true
+    }
+    
+    // MARK: - Export
+    /// Exports everything buffered now; runs whenever the app enters the background
+    public func flush() {
+        lock.lock()
+        let batch = takeBatch(at: ProcessInfo.processInfo.systemUptime)
+        lock.unlock()
+        
+        if let batch = batch {
+            exporter(batch)
+        }
+    }
+    
+    /// Finished spans not yet exported, oldest first
+    var pendingSpans: [TraceSpanRecord] {
+        lock.lock()
+        defer { lock.unlock() }
+        return finished
+    }
+    
+    // MARK: - Private Methods
+    private func begin(signpostName: StaticString, name: String, detail: String?, parentID: UInt64?) -> TraceSpan {
+        lock.lock()
+        let id = nextID
+        nextID += 1
+        lock.unlock()
+        
+        os_signpost(.begin, log: log, name: signpostName, signpostID: OSSignpostID(id), "%{public}s", detail ?? "")
+        return TraceSpan(id: id, parentID: parentID, name: name, signpostName: signpostName,
+                         start: ProcessInfo.processInfo.systemUptime)
+    }
+    
+    /// Must hold `lock`
+    private func takeBatchIfDue(at now: TimeInterval) -> [String: Any]? {
+        guard finished.count >= TRACE_EXPORT_BATCH_SIZE || now - lastExport >= TRACE_EXPORT_INTERVAL else {
+            return nil
+        }
+        return takeBatch(at: now)
+    }
+    
+    /// Must hold `lock`
+    private func takeBatch(at now: TimeInterval) -> [String: Any]? {
+        lastExport = now
+        guard !finished.isEmpty || droppedCount > 0 else { return nil }
+        
+        let batch: [String: Any] = [
+            "spans": finished.map { $0.dictionaryRepresentation },
+            "span_count": finished.count,
+            "dropped_spans": droppedCount
+        ]
+        finished.removeAll(keepingCapacity: true)
+        droppedCount = 0
+        return batch
+    }
+}
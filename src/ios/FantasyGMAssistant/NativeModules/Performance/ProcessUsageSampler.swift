@@ -0,0 +1,69 @@
+//
+// ProcessUsageSampler.swift
+// FantasyGMAssistant
+//
+// Constant-cost memory and CPU readings for the current process
+// Version: 1.0.0
+//
+
+import Foundation // iOS 14.0+
+
+// MARK: - Process Usage Sampler
+/// Reads CPU as the change in the task's accumulated CPU time since the previous reading, which
+/// takes two `task_info` calls instead of allocating and walking the thread list every sample.
+/// Not thread-safe; the owner serializes access.
+final class ProcessUsageSampler {
+    private var lastCPUTime: TimeInterval?
+    private var lastUptime: TimeInterval = 0
+    
+    /// Resident memory as a share of physical memory
+    static func memoryUsage() -> Float {
+        guard let info = basicInfo() else { return 0 }
+        return Float(info.resident_size) / Float(ProcessInfo.processInfo.physicalMemory)
+    }
+    
+    /// Percent of one core since the previous call, capped at 100. The first call returns 0.
+    func cpuUsage() -> Float {
+        let uptime = ProcessInfo.processInfo.systemUptime
+        guard let cpuTime = Self.totalCPUTime() else { return 0 }
+        defer {
+            lastCPUTime = cpuTime
+            lastUptime = uptime
+        }
+        
+        guard let lastCPUTime = lastCPUTime, uptime > lastUptime else { return 0 }
+        let usage = (cpuTime - lastCPUTime) / (uptime - lastUptime) * 100
+        return Float(min(max(usage, 0), 100))
+    }
+    
+    // MARK: - Private Methods
+    /// User and system time of live threads plus that of threads that have already exited
+    private static func totalCPUTime() -> TimeInterval? {
+        var info = task_thread_times_info()
+        var count = mach_msg_type_number_t(MemoryLayout<task_thread_times_info>.size / MemoryLayout<natural_t>.size)
+        let result = withUnsafeMutablePointer(to: &info) {
+            $0.withMemoryRebound(to: integer_t.self, capacity: Int(count)) {
+                task_info(mach_task_self_, task_flavor_t(TASK_THREAD_TIMES_INFO), $0, &count)
+            }
+        }
+        guard result == KERN_SUCCESS, let basic = basicInfo() else { return nil }
+        
+        return seconds(info.user_time) + seconds(info.system_time)
+            + seconds(basic.user_time) + seconds(basic.system_time)
+    }
+    
+    private static func basicInfo() -> mach_task_basic_info? {
+        var info = mach_task_basic_info()
+        var count = mach_msg_type_number_t(MemoryLayout<mach_task_basic_info>.size / MemoryLayout<natural_t>.size)
+        let result = withUnsafeMutablePointer(to: &info) {
+            $0.withMemoryRebound(to: integer_t.self, capacity: Int(count)) {
+                task_info(mach_task_self_, task_flavor_t(MACH_TASK_BASIC_INFO), $0, &count)
+            }
+        }
+        return result == KERN_SUCCESS ? info : nil
+    }
+    
+    private static func seconds(_ time: time_value_t) -> TimeInterval {
+        return TimeInterval(time.seconds) + TimeInterval(time.microseconds) / 1_000_000
+    }
+}
@@ -0,0 +1,243 @@
+//
+// NativeModuleBenchmarks.swift
+// FantasyGMAssistantBenchmarks
+//
+// Microbenchmarks for the native module hot paths over fixed datasets
+// Version: 1.0.0
+//
+
+import XCTest
+import Foundation
+@testable import FantasyGMAssistant
+
+// MARK: - Benchmark Constants
+private let BENCHMARK_ITERATIONS = 10
+private let ROSTER_SIZE = 500
+private let EVENT_BURST_SIZE = 1000
+/// Next power of two above the burst, so one burst fits without overflow
+private let EVENT_RING_CAPACITY = 1024
+private let ENCODE_SETTINGS_REPETITIONS = 1000
+private let BENCHMARK_CACHE_TTL: TimeInterval = 3600
+
+// MARK: - Synthetic Roster
+/// A roster player shaped like the stats payloads the app caches
+private struct RosterPlayer: Cacheable, Codable {
+    let id: String
+    let name: String
+    let position: String
+    let team: String
+    let weeklyProjections: [Double]
+    let injuryStatus: String?
+    let expiryDate: Date
+    
+    var cacheKey: String {
+        return "benchmark_roster_\(id)"
+    }
+    
+    var dataVersion: String {
+        return "1"
+    }
+    
+    func toCacheData() throws -> Data {
+        return try JSONEncoder().encode(self)
+    }
+    
+    static func fromCacheData(_ data: Data) throws -> RosterPlayer? {
+        return try JSONDecoder().decode(RosterPlayer.self, from: data)
+    }
+    
+    /// Same players on every run: a fixed linear congruential sequence, not a random source
+    static func syntheticRoster(count: Int) -> [RosterPlayer] {
+        let positions = ["QB", "RB", "WR", "TE", "K", "DEF"]
+        let teams = ["KC", "SF", "BUF", "PHI", "DAL", "MIA", "DET", "BAL"]
+        let expiry = Date(timeIntervalSinceReferenceDate: 4_000_000_000)
+        var state: UInt64 = 0x9E37_79B9_7F4A_7C15
+        func next() -> UInt64 {
+            state = state &* 6_364_136_223_846_793_005 &+ 1_442_695_040_888_963_407
+            return state >> 33
+        }
+        
+        return (0..<count).map { index in
+            RosterPlayer(id: "player_\(index)",
+                         name: "Player \(index)",
+                         position: positions[index % positions.count],
+                         team: teams[Int(next() % UInt64(teams.count))],
+                         weeklyProjections: (0..<17).map { _ in Double(next() % 3000) / 100 },
+                         injuryStatus: index % 9 == 0 ? "questionable" : nil,
+                         expiryDate: expiry)
+        }
+    }
+}
+
+// MARK: - Event Burst
+private struct BurstEvent {
+    let name: String
+    let parameters: [String: Any]
+    let requiresPrivacy: Bool
+    
+    /// A session's worth of screen and lineup events cycling through every interned name, with
+    /// every fourth event carrying PII and one in ten using a name the ring does not intern
+    static func burst(count: Int) -> [BurstEvent] {
+        let names = AnalyticsManager.AnalyticsEvents.all
+        return (0..<count).map { index in
+            let requiresPrivacy = index % 4 == 0
+            var parameters: [String: Any] = [
+                AnalyticsManager.AnalyticsProperties.TEAM_ID: "team_\(index % 12)",
+                AnalyticsManager.AnalyticsProperties.SPORT_TYPE: "nfl",
+                AnalyticsManager.AnalyticsProperties.DURATION_MS: index % 500,
+                "player_id": "player_\(index % ROSTER_SIZE)"
+            ]
+            if requiresPrivacy {
+                parameters[AnalyticsManager.AnalyticsProperties.USER_ID] = "user_\(index % 3)"
+                parameters["email"] = "manager\(index % 3)@example.com"
+            }
+            let name = index % 10 == 9 ? "custom_event_\(index % 5)" : names[index % names.count]
+            return BurstEvent(name: name, parameters: parameters, requiresPrivacy: requiresPrivacy)
+        }
+    }
+}
+
+// MARK: - Native Module Benchmarks
+/// Each benchmark runs under `measure` with clock, CPU and memory metrics. Numbers are only
+/// meaningful from a Release build without sanitizers. No baselines are committed, so a run
+/// reports timings but cannot fail on a regression.
+final class NativeModuleBenchmarks: XCTestCase {
+
+    // MARK: - Properties
+    private static let roster = RosterPlayer.syntheticRoster(count: ROSTER_SIZE)
+    private static let events = BurstEvent.burst(count: EVENT_BURST_SIZE)
+    
+    // MARK: - Cache
+    /// Stores the roster and reads every player back in one `getMany`, the path roster screens use
+    func testCacheRosterSetAndGetMany() {
+        let cache = CacheManager.shared
+        let roster = Self.roster
+        let keys = roster.map { $0.cacheKey }
+        
+        benchmark {
+            for player in roster {
+                cache.set(player, ttl: BENCHMARK_CACHE_TTL)
+            }
+            let lookup = expectation(description: "Roster read back")
+            cache.getMany(keys, type: RosterPlayer.self) { hits in
+                XCTAssertEqual(hits.count, ROSTER_SIZE)
+                lookup.fulfill()
+            }
+            wait(for: [lookup], timeout: 10.0)
+        }
+    }
+    
+    /// Key hashing runs on every disk tier lookup; it replaced the MD5 digest of the key
+    func testCacheKeyHashing() {
+        let keys = Self.roster.map { $0.cacheKey }
+        
+        benchmark {
+            var checksum: UInt64 = 0
+            for _ in 0..<10 {
+                for key in keys {
+                    checksum ^= CacheKeyHash.hash(key)
+                    checksum &+= UInt64(CacheKeyHash.fileName(for: key).utf8.count)
+                }
+            }
+            XCTAssertNotEqual(checksum, 0)
+        }
+    }
+    
+    // MARK: - Analytics
+    /// Producer cost of `trackEvent` for a 1000-event burst, plus the single drain it schedules
+    func testAnalyticsEventBurstEnqueueAndDrain() {
+        let ring = AnalyticsEventRing(capacity: EVENT_RING_CAPACITY, names: AnalyticsManager.AnalyticsEvents.all)
+        let events = Self.events
+        
+        benchmark {
+            for event in events {
+                _ = ring.enqueue(event.name, parameters: event.parameters, requiresPrivacy: event.requiresPrivacy)
+            }
+            ring.beginDrain()
+            XCTAssertEqual(ring.drain { _, _ in }, EVENT_BURST_SIZE)
+        }
+        XCTAssertEqual(ring.overflowCount, 0)
+    }
+    
+    /// The per-event parameter work: privacy filtering where required, then the session context
+    /// merge that immediate sends perform
+    func testAnalyticsEventEnrichment() {
+        let manager = AnalyticsManager.shared
+        let events = Self.events
+        
+        benchmark {
+            var enrichedCount = 0
+            for event in events {
+                let parameters = manager.eventParameters(event.parameters, requiresPrivacy: event.requiresPrivacy)
+                enrichedCount += manager.enrichEventParameters(parameters).count
+            }
+            XCTAssertGreaterThan(enrichedCount, EVENT_BURST_SIZE)
+        }
+    }
+    
+    // MARK: - Media
+    /// Encoder selection and FFmpeg argument generation, one test per device tier because the
+    /// profile a tier maps to decides which branch runs. `measure` may only run once per test.
+    func testEncodeSettingsLowTier() {
+        benchmarkEncodeSettings(capabilities(processorCount: 2, memoryGB: 2))
+    }
+    
+    func testEncodeSettingsMidTier() {
+        benchmarkEncodeSettings(capabilities(processorCount: 4, memoryGB: 3))
+    }
+    
+    func testEncodeSettingsHighTier() {
+        benchmarkEncodeSettings(capabilities(processorCount: 6, memoryGB: 6))
+    }
+    
+    /// A hot device drops to cheaper settings on every tier
+    func testEncodeSettingsThrottled() {
+        let device = capabilities(processorCount: 6, memoryGB: 6, thermalState: .serious)
+        benchmarkEncodeSettings(device)
+    }
+    
+    /// The simulator and failed hardware sessions take the x264 path
+    func testEncodeSettingsSoftwareOnly() {
+        let device = capabilities(processorCount: 6, memoryGB: 6, hardwareEncoding: false)
+        benchmarkEncodeSettings(device)
+    }
+    
+    // MARK: - Helper Methods
+    private func benchmark(_ body: () -> Void) {
+        // One warm-up run so lazy statics, caches and first-touch page faults are not measured
+        body()
+        
+        let options = XCTMeasureOptions()
+        options.iterationCount = BENCHMARK_ITERATIONS
+        measure(metrics: [XCTClockMetric(), XCTCPUMetric(), XCTMemoryMetric()], options: options, block: body)
+    }
+    
+    private func benchmarkEncodeSettings(_ device: DeviceCapabilities) {
+        let options = ["high", "medium", "low"].map {
+            MediaProcessingOptions(quality: $0, format: "mp4", optimization: "quality",
+                                   maxDuration: 300, maxFileSize: 100 * 1024 * 1024)
+        }
+        
+        benchmark {
+            var length = 0
+            for repetition in 0..<ENCODE_SETTINGS_REPETITIONS {
+                let option = options[repetition % options.count]
+                let settings = VideoEncodeSettings.select(for: option, duration: 120, capabilities: device)
+                length += settings.ffmpegArguments.utf8.count + VideoEncodeSettings.audioArguments.utf8.count
+            }
+            XCTAssertGreaterThan(length, 0)
+        }
+    }
+    
+    private func capabilities(processorCount: Int,
+                              memoryGB: UInt64,
+                              thermalState: ProcessInfo.ThermalState = .nominal,
+                              hardwareEncoding: Bool = true) -> DeviceCapabilities {
+        return DeviceCapabilities(processorCount: processorCount,
+                                  physicalMemory: memoryGB * 1_000_000_000,
+                                  thermalState: thermalState,
+                                  isLowPowerModeEnabled: false,
+                                  supportsHardwareEncoding: hardwareEncoding,
+                                  supportsHEVCEncoding: hardwareEncoding)
+    }
+}
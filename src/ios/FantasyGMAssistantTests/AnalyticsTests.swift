@@ -218,6 +218,295 @@ final class AnalyticsTests: XCTestCase {
             XCTAssertTrue(self.mockRUMMonitor.hasEvent(named: offlineEvent))
         }
     }
+    
+    // MARK: - Pipeline Tests
+    func testPipelinePersistsEventsAcrossRelaunchAndUploadsInBatches() {
+        let directory = FileManager.default.temporaryDirectory.appendingPathComponent(UUID().uuidString)
+        defer { try? FileManager.default.removeItem(at: directory) }
+        
+        var policy = AnalyticsPipelinePolicy()
+        policy.maxBatchCount = 2
+        
+        // Tracked while offline, then the app is killed before anything is uploaded
+        var offline = AnalyticsPipeline(directory: directory, policy: policy) { _, _ in
+            XCTFail("Nothing should upload while offline")
+            return false
+        }
+        for index in 0..<5 {
+            offline?.append("view_player", parameters: ["index": index], priority: .normal)
+        }
+        XCTAssertEqual(offline?.currentStats.pendingEvents, 5)
+        offline = nil
+        
+        var batches: [[AnalyticsEvent]] = []
+        let relaunched = AnalyticsPipeline(directory: directory, policy: policy) { events, _ in
+            batches.append(events)
+            return true
+        }
+        XCTAssertEqual(relaunched?.currentStats.pendingEvents, 5, "Pending events should survive a relaunch")
+        
+        let flushed = expectation(description: "Pipeline flush")
+        relaunched?.setOnline(true)
+        relaunched?.flush { uploaded, remaining in
+            XCTAssertEqual(uploaded, 0, "Going online should already have drained the log")
+            XCTAssertEqual(remaining, 0)
+            flushed.fulfill()
+        }
+        wait(for: [flushed], timeout: TEST_TIMEOUT)
+        
+        XCTAssertEqual(batches.map { $0.count }, [2, 2, 1])
+        XCTAssertEqual(batches.flatMap { $0 }.compactMap { $0.parameters["index"] as? Int }, [0, 1, 2, 3, 4])
+        XCTAssertEqual(relaunched?.currentStats.uploadedBatches, 3)
+    }
+    
+    func testPipelineBackpressureSamplesLowPriorityEventsOnly() {
+        let directory = FileManager.default.temporaryDirectory.appendingPathComponent(UUID().uuidString)
+        defer { try? FileManager.default.removeItem(at: directory) }
+        
+        var policy = AnalyticsPipelinePolicy()
+        policy.maxLogBytes = 1
+        let pipeline = AnalyticsPipeline(directory: directory, policy: policy) { _, _ in true }
+        
+        // The log is over its budget after the first event, so low-priority events drop to 1 in 50
+        for _ in 0..<100 {
+            pipeline?.append("view_player", parameters: [:], priority: .low)
+        }
+        for _ in 0..<10 {
+            pipeline?.append("error_API_ERROR", parameters: [:], priority: .critical)
+        }
+        
+        let stats = pipeline?.currentStats
+        XCTAssertEqual(stats?.pendingEvents, 12, "Critical events should never be sampled")
+        XCTAssertEqual(stats?.sampledOutEvents, 98)
+        XCTAssertEqual(policy.sampleInterval(for: .low, fill: 2), 50)
+        XCTAssertEqual(policy.sampleInterval(for: .critical, fill: 2), 1)
+    }
+    
+    // MARK: - Event Ring Tests
+    func testEventRingKeepsPerProducerOrderUnderConcurrentEnqueue() {
+        let ring = AnalyticsEventRing(capacity: 4096, names: ["view_player", "update_lineup"])
+        let producers = 4
+        let eventsPerProducer = 500
+        
+        DispatchQueue.concurrentPerform(iterations: producers) { producer in
+            for index in 0..<eventsPerProducer {
+                let name = producer % 2 == 0 ? "view_player" : "custom_event_\(producer)"
+                XCTAssertTrue(ring.enqueue(name, parameters: ["producer": producer, "index": index], requiresPrivacy: false))
+            }
+        }
+        
+        var lastIndex = [Int](repeating: -1, count: producers)
+        var names: Set<String> = []
+        ring.beginDrain()
+        let drained = ring.drain { name, record in
+            guard let producer = record.parameters?["producer"] as? Int,
+                  let index = record.parameters?["index"] as? Int else {
+                return XCTFail("Record lost its parameters")
+            }
+            XCTAssertEqual(index, lastIndex[producer] + 1, "Events from one producer must stay in order")
+            lastIndex[producer] = index
+            names.insert(name)
+        }
+        
+        XCTAssertEqual(drained, producers * eventsPerProducer)
+        XCTAssertEqual(names, ["view_player", "custom_event_1", "custom_event_3"])
+        XCTAssertEqual(ring.overflowCount, 0)
+    }
+    
+    func testEventRingRejectsEnqueueWhenFullWithoutBlocking() {
+        let ring = AnalyticsEventRing(capacity: 4, names: ["view_player"])
+        
+        for _ in 0..<4 {
+            XCTAssertTrue(ring.enqueue("view_player", parameters: nil, requiresPrivacy: false))
+        }
+        XCTAssertFalse(ring.enqueue("view_player", parameters: nil, requiresPrivacy: false))
+        XCTAssertEqual(ring.overflowCount, 1)
+        
+        // Only the first request after a drain begins schedules the consumer
+        XCTAssertTrue(ring.requestDrain())
+        XCTAssertFalse(ring.requestDrain())
+        ring.beginDrain()
+        XCTAssertEqual(ring.drain { _, _ in }, 4)
+        XCTAssertTrue(ring.enqueue("view_player", parameters: nil, requiresPrivacy: true), "Drained slots are reusable")
+        XCTAssertTrue(ring.requestDrain())
+    }
+    
+    // MARK: - Session Context Tests
+    func testSessionContextIsRebuiltOnlyWhenUserPropertiesOrNetworkChange() {
+        var filterCalls = 0
+        let context = AnalyticsSessionContext(
+            staticAttributes: ["app_version": "1.0.0"],
+            networkStatusKey: "network_status"
+        ) { attributes in
+            filterCalls += 1
+            return attributes.filter { $0.key != "email" }
+        }
+        
+        let first = context.snapshot()
+        XCTAssertEqual(context.snapshot().version, first.version, "Unchanged context should be served from cache")
+        XCTAssertEqual(first.attributes["network_status"] as? String, "offline")
+        XCTAssertFalse(context.setNetworkConnected(false), "Repeated path updates should not invalidate")
+        XCTAssertEqual(filterCalls, 1)
+        
+        context.setUserProperties(["user_id": TEST_USER_ID, "email": "test@example.com", "app_version": "spoofed"])
+        XCTAssertTrue(context.setNetworkConnected(true))
+        
+        let second = context.snapshot()
+        XCTAssertGreaterThan(second.version, first.version)
+        XCTAssertEqual(second.attributes["user_id"] as? String, TEST_USER_ID)
+        XCTAssertEqual(second.attributes["app_version"] as? String, "1.0.0", "Static attributes win over user properties")
+        XCTAssertEqual(second.attributes["network_status"] as? String, "connected")
+        XCTAssertNil(second.filteredAttributes["email"])
+        XCTAssertEqual(filterCalls, 2)
+    }
+    
+    func testPersistedEventsKeepTheContextVersionTheyWereTrackedUnder() {
+        let directory = FileManager.default.temporaryDirectory.appendingPathComponent(UUID().uuidString)
+        try? FileManager.default.createDirectory(at: directory, withIntermediateDirectories: true)
+        defer { try? FileManager.default.removeItem(at: directory) }
+        let historyURL = directory.appendingPathComponent("context_history.json")
+        
+        // Tracked offline before and after sign-in, then the app is killed
+        let context = AnalyticsSessionContext(staticAttributes: [:], networkStatusKey: "network_status",
+                                              historyURL: historyURL) { $0 }
+        let anonymous = context.snapshot().version
+        context.setUserProperties(["user_id": TEST_USER_ID])
+        let signedIn = context.snapshot().version
+        var offline = AnalyticsPipeline(directory: directory) { _, _ in false }
+        offline?.append("view_team", parameters: [:], priority: .normal, contextVersion: anonymous)
+        offline?.append("view_player", parameters: [:], priority: .normal, contextVersion: signedIn)
+        XCTAssertEqual(offline?.currentStats.pendingEvents, 2)
+        offline = nil
+        
+        // A different user signs in after relaunch, before the backlog uploads
+        let relaunchedContext = AnalyticsSessionContext(staticAttributes: [:], networkStatusKey: "network_status",
+                                                        historyURL: historyURL) { $0 }
+        relaunchedContext.setUserProperties(["user_id": "other_user"])
+        XCTAssertGreaterThan(relaunchedContext.snapshot().version, signedIn, "Versions must not be reused")
+        
+        var uploaded: [AnalyticsEvent] = []
+        let relaunched = AnalyticsPipeline(directory: directory) { events, _ in
+            uploaded += events
+            return true
+        }
+        let flushed = expectation(description: "Pipeline flush")
+        relaunched?.setOnline(true)
+        relaunched?.flush { _, _ in flushed.fulfill() }
+        wait(for: [flushed], timeout: TEST_TIMEOUT)
+        
+        XCTAssertEqual(uploaded.map { $0.contextVersion }, [anonymous, signedIn])
+        let userIDs = uploaded.map {
+            relaunchedContext.snapshot(version: $0.contextVersion)?.attributes["user_id"] as? String
+        }
+        XCTAssertEqual(userIDs, [nil, TEST_USER_ID], "Each event should report the user it was tracked under")
+    }
+    
+    // MARK: - Privacy Tests
+    func testPrivacyManagerMasksByCompiledRulesAndLeavesSafeParametersUntouched() {
+        let privacy = PrivacyManager()
+        
+        let safe: [String: Any] = ["sport_type": "nfl", "duration_ms": 120, "players_involved": 2]
+        let unchanged = privacy.filterSensitiveData(from: safe)
+        XCTAssertNil(unchanged["pii_masked"], "Parameters without PII should pass straight through")
+        XCTAssertEqual(unchanged.count, safe.count)
+        
+        let masked = privacy.filterSensitiveData(from: [
+            "email": "test@example.com",
+            "home_address": "1 Main St",
+            "error_message": "No account for test@example.com",
+            "team_id": "test_team_123"
+        ])
+        XCTAssertEqual(masked["email"] as? String, "[EMAIL]")
+        XCTAssertNil(masked["home_address"])
+        XCTAssertEqual(masked["error_message"] as? String, "No account for [EMAIL]")
+        XCTAssertEqual(masked["team_id"] as? String, "test_team_123", "IDs are only pseudonymized at strict level")
+        XCTAssertEqual(masked["pii_masked"] as? Bool, true)
+    }
+    
+    func testStrictPrivacyPseudonymizesIdentifiersStably() {
+        let privacy = PrivacyManager()
+        privacy.configure(with: PrivacyConfig(gdprEnabled: true))
+        
+        let first = privacy.filterSensitiveData(from: ["user_id": TEST_USER_ID, "device_info": ["model": "iPhone"]])
+        let second = privacy.filterSensitiveData(from: ["user_id": TEST_USER_ID])
+        let pseudonym = first["user_id"] as? String
+        
+        XCTAssertNotNil(pseudonym)
+        XCTAssertNotEqual(pseudonym, TEST_USER_ID)
+        XCTAssertEqual(second["user_id"] as? String, pseudonym, "Repeated IDs should map to the same pseudonym")
+        XCTAssertEqual((first["device_info"] as? [String: Any])?["model"] as? String, "iPhone")
+        XCTAssertEqual(first["privacy_level"] as? Int, PrivacyLevel.strict.rawValue)
+    }
+    
+    func testMinimalPrivacyDropsFreeTextThatLowerLevelsScan() {
+        let privacy = PrivacyManager()
+        privacy.configure(with: PrivacyConfig(level: .minimal))
+        
+        let filtered = privacy.filterSensitiveData(from: [
+            "error_message": "No account for test@example.com",
+            "search_query": "QB sleepers",
+            "error_code": 404
+        ])
+        XCTAssertNil(filtered["error_message"], "The minimal drop must win over the standard scan rule")
+        XCTAssertNil(filtered["search_query"])
+        XCTAssertEqual(filtered["error_code"] as? Int, 404)
+        
+        privacy.configure(with: PrivacyConfig(level: .standard))
+        let scanned = privacy.filterSensitiveData(from: ["error_message": "No account for test@example.com"])
+        XCTAssertEqual(scanned["error_message"] as? String, "No account for [EMAIL]")
+    }
+    
+    func testPrivacyRulesMatchWholeKeySegmentsOnly() {
+        let privacy = PrivacyManager()
+        
+        let unrelated: [String: Any] = ["classname": "WR", "is_mobile": true, "tokens_remaining": 3]
+        let unchanged = privacy.filterSensitiveData(from: unrelated)
+        XCTAssertNil(unchanged["pii_masked"], "Fragments inside longer segments should not match")
+        XCTAssertEqual(unchanged["is_mobile"] as? Bool, true)
+        
+        let masked = privacy.filterSensitiveData(from: ["mobile_number": "555-123-4567", "authToken": "abc"])
+        XCTAssertEqual(masked["mobile_number"] as? String, "[PHONE]")
+        XCTAssertNil(masked["authToken"], "camelCase keys should be split into segments")
+    }
+    
+    // MARK: - Sampling Tests
+    func testEventShaperSamplesAndRateLimitsPerEventTypeAndCountsDrops() {
+        var draws = [0.1, 0.9, 0.1, 0.1]
+        let shaper = AnalyticsEventShaper(
+            rules: [
+                "view_player": AnalyticsEventRule(sampleRate: 0.5),
+                "update_lineup": AnalyticsEventRule(ratePerSecond: 1, burst: 2)
+            ],
+            now: 0
+        ) { draws.removeFirst() }
+        
+        XCTAssertEqual(shaper.decide("view_player", at: 1), .keep(sampleRate: 0.5))
+        XCTAssertEqual(shaper.decide("view_player", at: 1), .sampledOut)
+        XCTAssertEqual(shaper.decide("update_lineup", at: 1), .keep(sampleRate: 1))
+        XCTAssertEqual(shaper.decide("update_lineup", at: 1), .keep(sampleRate: 1))
+        XCTAssertEqual(shaper.decide("update_lineup", at: 1), .rateLimited, "Burst exhausted")
+        XCTAssertEqual(shaper.decide("update_lineup", at: 2), .keep(sampleRate: 1), "One token refilled per second")
+        XCTAssertEqual(shaper.decide("run_simulation", at: 2), .keep(sampleRate: 1), "Events without rules pass")
+        
+        XCTAssertNil(shaper.takeSummary(at: 30), "Summaries are reported at most once per interval")
+        let summary = shaper.takeSummary(at: 61)
+        XCTAssertEqual(summary?.sampledOut, ["view_player": 1])
+        XCTAssertEqual(summary?.rateLimited, ["update_lineup": 1])
+        XCTAssertNil(shaper.takeSummary(at: 200), "Counts reset after each summary")
+    }
+    
+    func testEventShaperNeverDropsErrorsAndAppliesRemoteRules() {
+        let shaper = AnalyticsEventShaper(rules: [:], now: 0) { 0.99 }
+        let rule = AnalyticsEventRule(dictionary: ["sample_rate": 0, "rate_per_second": 1])
+        XCTAssertNotNil(rule)
+        XCTAssertNil(AnalyticsEventRule(dictionary: ["burst": 5]), "A rule must sample or limit")
+        
+        shaper.updateRules(["view_player": rule!, "error_network": rule!])
+        XCTAssertEqual(shaper.decide("view_player", at: 1), .sampledOut)
+        for _ in 0..<10 {
+            XCTAssertEqual(shaper.decide("error_network", at: 1), .keep(sampleRate: 1))
+        }
+    }
 }
 
 // MARK: - Mock Classes
@@ -146,6 +146,33 @@ class AuthenticationTests: XCTestCase {
         wait(for: [expectation], timeout: TEST_TIMEOUT * Double(MAX_RETRY_ATTEMPTS))
     }
     
+    func testRateLimiterBucketsPerIdentifierWithinFixedTable() {
+        let limiter = AuthRateLimiter(burst: 3, window: 300)
+        
+        XCTAssertEqual((0..<4).map { _ in limiter.allow(TEST_EMAIL) }, [true, true, true, false])
+        XCTAssertTrue(limiter.allow("other@example.com"), "Buckets should be per identifier")
+        
+        // Far more identifiers than slots never throw an untouched identifier out
+        let others = (0..<5_000).filter { limiter.allow("user\($0)@example.com") }
+        XCTAssertEqual(others.count, 5_000)
+        XCTAssertFalse(limiter.allow(TEST_EMAIL), "A live bucket should survive the table filling up")
+        
+        // Checks from many threads at once take exactly the burst
+        let concurrent = AuthRateLimiter(burst: 3, window: 300)
+        let lock = NSLock()
+        var allowed = 0
+        DispatchQueue.concurrentPerform(iterations: 64) { _ in
+            guard concurrent.allow(TEST_EMAIL) else { return }
+            lock.lock()
+            allowed += 1
+            lock.unlock()
+        }
+        XCTAssertEqual(allowed, 3)
+        
+        limiter.reset()
+        XCTAssertTrue(limiter.allow(TEST_EMAIL))
+    }
+    
     // MARK: - Token Management Tests
     func testTokenRefresh() {
         expectation = expectation(description: "Token refresh")
@@ -180,6 +207,48 @@ class AuthenticationTests: XCTestCase {
         wait(for: [expectation], timeout: TEST_TIMEOUT)
     }
     
+    func testTokenRefresherSharesOneFetchAndRefreshesAheadOfExpiry() {
+        let store = AuthTokenStore()
+        let queue = DispatchQueue(label: "com.fantasygm.tests.tokenrefresher")
+        let fetchLock = NSLock()
+        var fetches = 0
+        let proactiveRefresh = expectation(description: "Token refreshed ahead of expiry")
+        
+        let refresher = AuthTokenRefresher(store: store, queue: queue, jitter: { 0 }) { completion in
+            fetchLock.lock()
+            fetches += 1
+            let count = fetches
+            fetchLock.unlock()
+            if count == 2 {
+                proactiveRefresh.fulfill()
+            }
+            
+            // One second past the five minute refresh lead, so the next refresh comes due almost at once
+            let token = AuthToken(value: "token-\(count)", expirationDate: Date().addingTimeInterval(301))
+            DispatchQueue.global().asyncAfter(deadline: .now() + 0.1) {
+                completion(.success(token))
+            }
+        }
+        XCTAssertNil(store.token())
+        
+        let refreshed = expectation(description: "Concurrent refreshes completed")
+        refreshed.expectedFulfillmentCount = 3
+        for _ in 0..<3 {
+            refresher.refresh { result in
+                XCTAssertEqual(try? result.get().value, "token-1", "Concurrent callers should share one fetch")
+                refreshed.fulfill()
+            }
+        }
+        wait(for: [refreshed], timeout: TEST_TIMEOUT)
+        XCTAssertEqual(store.token(), "token-1")
+        XCTAssertNil(store.token(validFor: 400), "Tokens expiring too soon should not be handed out")
+        
+        wait(for: [proactiveRefresh], timeout: TEST_TIMEOUT)
+        refresher.stop()
+        queue.sync {}
+        XCTAssertNil(store.token(), "Sign-out should clear the cached token")
+    }
+    
     // MARK: - User Role Tests
     func testUserRoles() {
         expectation = expectation(description: "User roles")
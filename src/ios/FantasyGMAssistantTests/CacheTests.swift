@@ -57,6 +57,24 @@ private class MockCacheable: Cacheable {
     }
 }
 
+// MARK: - Test Helpers
+private final class AtomicCounter {
+    private let lock = NSLock()
+    private var count = 0
+    
+    var value: Int {
+        lock.lock()
+        defer { lock.unlock() }
+        return count
+    }
+    
+    func increment() {
+        lock.lock()
+        count += 1
+        lock.unlock()
+    }
+}
+
 // MARK: - Cache Tests
 class CacheTests: XCTestCase {
     private var cacheManager: CacheManager!
@@ -133,6 +151,105 @@ class CacheTests: XCTestCase {
         }
     }
     
+    // MARK: - Async Lookup Tests
+    func testAsyncLookupDoesNotBlockCaller() async {
+        cacheManager.set(mockPlayerStats, ttl: CacheConfig.playerStats)
+
+        let cached = await cacheManager.get(mockPlayerStats.cacheKey, type: MockCacheable.self)
+        XCTAssertEqual(cached?.data, mockPlayerStats.data, "Async lookup should return the stored object")
+
+        let missing = await cacheManager.get(UUID().uuidString, type: MockCacheable.self)
+        XCTAssertNil(missing, "Async lookup should resolve with nil on a miss")
+    }
+
+    func testRawDataLookup() {
+        let expectation = XCTestExpectation(description: "Raw data lookup")
+        cacheManager.set(mockWeatherData, ttl: CacheConfig.weatherData)
+
+        cacheManager.getData(forKey: mockWeatherData.cacheKey) { data, error in
+            XCTAssertNil(error)
+            XCTAssertEqual(data, try? self.mockWeatherData.toCacheData(), "Bridge lookup should return the stored bytes")
+            expectation.fulfill()
+        }
+
+        wait(for: [expectation], timeout: PERFORMANCE_THRESHOLD_SECONDS)
+    }
+
+    func testBatchLookupReturnsHitsOnly() {
+        let expectation = XCTestExpectation(description: "Batch lookup")
+        let roster = [mockPlayerStats!, mockWeatherData!, mockTradeAnalysis!]
+        let missingKey = UUID().uuidString
+        cacheManager.setMany(roster, ttl: CacheConfig.playerStats)
+        
+        cacheManager.getMany(roster.map { $0.cacheKey } + [missingKey], type: MockCacheable.self) { results in
+            XCTAssertEqual(results.count, roster.count, "Batch lookup should return every stored key")
+            XCTAssertEqual(results[self.mockWeatherData.cacheKey]?.data, self.mockWeatherData.data)
+            XCTAssertNil(results[missingKey], "Misses should be omitted from the batch result")
+            expectation.fulfill()
+        }
+        
+        wait(for: [expectation], timeout: PERFORMANCE_THRESHOLD_SECONDS)
+    }
+    
+    // MARK: - Compression Tests
+    func testCompressedEntriesRoundTripAndChargeStoredSize() async {
+        let table = MockCacheable(data: String(repeating: "QB,RB,WR,TE;", count: 2000))
+        let baseline = cacheManager.metrics.memorySize
+        cacheManager.set(table, ttl: CacheConfig.playerStats, compression: .lzfse)
+        
+        let cached = await cacheManager.get(table.cacheKey, type: MockCacheable.self)
+        XCTAssertEqual(cached?.data, table.data, "Compressed entries should decode to the original payload")
+        
+        let rawSize = (try? table.toCacheData().count) ?? 0
+        XCTAssertLessThan(cacheManager.metrics.memorySize - baseline, rawSize, "Memory should be charged at the compressed size")
+    }
+    
+    func testSmallPayloadsSkipCompression() {
+        let payload = Data("tiny".utf8)
+        let stored = CacheCodec.encode(payload, using: .lz4)
+        XCTAssertEqual(stored.data, payload)
+        XCTAssertTrue(stored.flags.isEmpty, "Payloads under the threshold should be stored raw")
+    }
+    
+    // MARK: - Read-Through Loading Tests
+    func testConcurrentMissesShareOneLoad() {
+        let expectation = XCTestExpectation(description: "Coalesced loads")
+        expectation.expectedFulfillmentCount = 10
+        let key = UUID().uuidString
+        let payload = Data("projection".utf8)
+        let loadCount = AtomicCounter()
+        
+        for _ in 0..<10 {
+            cacheManager.getOrLoadData(forKey: key, ttl: CacheConfig.playerStats, loader: { done in
+                loadCount.increment()
+                DispatchQueue.global().asyncAfter(deadline: .now() + 0.2) { done(.success(payload)) }
+            }, completion: { result in
+                XCTAssertEqual(try? result.get(), payload, "Every waiter should receive the loaded data")
+                expectation.fulfill()
+            })
+        }
+        
+        wait(for: [expectation], timeout: PERFORMANCE_THRESHOLD_SECONDS)
+        XCTAssertEqual(loadCount.value, 1, "Concurrent misses should trigger a single load")
+    }
+    
+    func testStaleEntryServedWhileRevalidating() {
+        let expectation = XCTestExpectation(description: "Stale while revalidate")
+        let key = UUID().uuidString
+        let stale = Data("stale".utf8)
+        let fresh = Data("fresh".utf8)
+        cacheManager.setData(stale, withKey: key, ttl: -1, callback: nil)
+        
+        cacheManager.getOrLoadData(forKey: key, ttl: CacheConfig.playerStats, staleWhileRevalidate: 60, loader: {
+            $0(.success(fresh))
+        }, completion: { result in
+            XCTAssertEqual(try? result.get(), stale, "Expired entry should be served within the stale window")
+            expectation.fulfill()
+        })
+        
+        wait(for: [expectation], timeout: PERFORMANCE_THRESHOLD_SECONDS)
+    }
+    
     // MARK: - Concurrent Access Tests
     func testConcurrentAccess() {
         let concurrentQueue = DispatchQueue(label: "concurrent.cache.test", attributes: .concurrent)
@@ -169,6 +286,127 @@ class CacheTests: XCTestCase {
         XCTAssertNotNil(cached, "Data should be recoverable from disk after memory warning")
     }
     
+    func testDiskTTLSurvivesMemoryEviction() async throws {
+        cacheManager.set(mockTradeAnalysis, ttl: 1)
+
+        // Drop the memory tier so the lookup has to use the on-disk record
+        cacheManager.trimMemory(fraction: 1.0, level: .critical)
+
+        let cached = await cacheManager.get(mockTradeAnalysis.cacheKey, type: MockCacheable.self)
+        XCTAssertNotNil(cached, "Disk record should be served before its TTL elapses")
+
+        try await Task.sleep(nanoseconds: 1_500_000_000)
+        cacheManager.trimMemory(fraction: 1.0, level: .critical)
+
+        let expired = await cacheManager.get(mockTradeAnalysis.cacheKey, type: MockCacheable.self)
+        XCTAssertNil(expired, "Disk record should honor the stored expiry rather than a default TTL")
+    }
+
+    func testOverwriteEvictedBeforeDiskWriteIsNotServedStale() async {
+        let original = MockCacheable(data: "original")
+        let updated = MockCacheable(data: "updated")
+        updated.cacheKey = original.cacheKey
+        cacheManager.set(original, ttl: CacheConfig.playerStats)
+        _ = await cacheManager.get(original.cacheKey, type: MockCacheable.self)
+
+        // Drop the new entry from memory while its disk write may still be queued
+        cacheManager.set(updated, ttl: CacheConfig.playerStats)
+        _ = await cacheManager.get(original.cacheKey, type: MockCacheable.self)
+        cacheManager.trimMemory(fraction: 1.0, level: .critical)
+
+        let cached = await cacheManager.get(original.cacheKey, type: MockCacheable.self)
+        XCTAssertEqual(cached?.data, "updated", "A pending write should shadow the older disk record")
+    }
+
+    func testSizeAccountingTracksRemovals() {
+        let expectation = XCTestExpectation(description: "Size accounting")
+        let payload = Data(repeating: 0xAB, count: 4096)
+        let key = UUID().uuidString
+        let baseline = cacheManager.metrics
+        
+        cacheManager.setData(payload, withKey: key, ttl: CacheConfig.playerStats) { _ in
+            let stored = self.cacheManager.metrics
+            XCTAssertGreaterThanOrEqual(stored.size - baseline.size, payload.count, "Disk bytes should include the record")
+            XCTAssertEqual(stored.memorySize - baseline.memorySize, payload.count, "Memory bytes should include the entry")
+            
+            self.cacheManager.removeData(forKey: key) { _ in
+                let removed = self.cacheManager.metrics
+                XCTAssertEqual(removed.size, baseline.size, "Removal should release disk bytes")
+                XCTAssertEqual(removed.memorySize, baseline.memorySize, "Removal should release memory bytes")
+                expectation.fulfill()
+            }
+        }
+        
+        wait(for: [expectation], timeout: PERFORMANCE_THRESHOLD_SECONDS)
+    }
+    
+    func testLRUEvictsLeastRecentlyUsedOverBudget() {
+        let lru = CacheLRU<Int>(costLimit: 10)
+        lru.insert(1, forKey: "a", cost: 4)
+        lru.insert(2, forKey: "b", cost: 4)
+        XCTAssertEqual(lru.value(forKey: "a"), 1)
+        
+        let evicted = lru.insert(3, forKey: "c", cost: 4)
+        XCTAssertEqual(evicted.map { $0.key }, ["b"], "Least recently used key should be evicted first")
+        XCTAssertEqual(lru.totalCost, 8)
+        XCTAssertEqual(lru.count, 2)
+    }
+    
+    // MARK: - Pack Store Tests
+    func testPackStoreReopensLatestRecords() throws {
+        let directory = NSTemporaryDirectory() + UUID().uuidString
+        defer { try? FileManager.default.removeItem(atPath: directory) }
+        
+        let first = Data("first".utf8)
+        let second = Data("second".utf8)
+        let expiry = Date().addingTimeInterval(60)
+        
+        let store = try XCTUnwrap(CachePackStore(directory: directory))
+        try store.write(first, header: CacheRecordHeader(payload: first, expiryDate: expiry, version: "1.0"), for: "a")
+        try store.write(second, header: CacheRecordHeader(payload: second, expiryDate: expiry, version: "1.0"), for: "a")
+        try store.write(first, header: CacheRecordHeader(payload: first, expiryDate: expiry, version: "1.0"), for: "b")
+        store.remove("b")
+        let expired = CacheRecordHeader(payload: first, expiryDate: Date().addingTimeInterval(-60), version: "1.0")
+        try store.write(first, header: expired, for: "c")
+        XCTAssertEqual(store.removeExpired(version: "1.0", now: Date()), 1)
+        
+        // A fresh instance rebuilds its index from the pack on disk
+        let reopened = try XCTUnwrap(CachePackStore(directory: directory))
+        XCTAssertEqual(try reopened.record(for: "a")?.payload, second, "Latest record should win after reopen")
+        XCTAssertNil(try reopened.record(for: "b"), "Tombstoned keys should stay removed after reopen")
+        XCTAssertNil(reopened.header(for: "c"), "Purged expired records should not come back as stale")
+    }
+    
+    func testDiskBudgetCountsDeadBytesAndRecoversFileKeys() throws {
+        let directory = NSTemporaryDirectory() + UUID().uuidString
+        defer { try? FileManager.default.removeItem(atPath: directory) }
+        
+        let payload = Data(repeating: 7, count: 512)
+        let entry = CacheEntry(data: payload, expiryDate: Date().addingTimeInterval(60), version: "1.0", flags: [])
+        let store = try XCTUnwrap(CachePackStore(directory: directory + "/pack"))
+        let tier = CacheDiskTier(store: store, costLimit: 4096, version: "1.0")
+        
+        // Overwrites leave dead records behind; the write path compacts before they pass the budget
+        for _ in 0..<20 {
+            _ = try tier.write([("roster", entry)])
+            XCTAssertLessThanOrEqual(tier.totalCost, 4096)
+        }
+        XCTAssertEqual(try tier.read("roster")?.data, payload)
+        
+        // Per-file records from an earlier launch are charged once their keys are read back
+        let files = FileDiskCacheStore(directory: directory + "/files")
+        try files.write(payload, header: CacheRecordHeader(payload: payload, expiryDate: entry.expiryDate,
+                                                           version: "1.0"), for: "player_1")
+        let relaunched = FileDiskCacheStore(directory: directory + "/files")
+        XCTAssertEqual(relaunched.storedEntries().map { $0.key }, ["player_1"])
+    }
+    
+    func testKeyHashMatchesXXH64() {
+        XCTAssertEqual(CacheKeyHash.hash(""), 0xEF46_DB37_51D8_E999)
+        XCTAssertEqual(CacheKeyHash.hash("abc"), 0x44BC_2CF5_AD77_0999)
+        XCTAssertEqual(CacheKeyHash.fileName(for: "abc"), "44bc2cf5ad770999", "File names should be zero-padded lowercase hex")
+    }
+    
     // MARK: - Cache Size Tests
     func testCacheSizeManagement() {
         // Store large objects
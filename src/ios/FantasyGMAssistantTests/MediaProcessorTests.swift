@@ -107,6 +107,25 @@ class MediaProcessorTests: XCTestCase {
         await waitForExpectations(timeout: 30.0)
     }
     
+    func testPipelineProgressCombinesConcurrentStagesMonotonically() {
+        var reported: [Double] = []
+        let progress = MediaPipelineProgress { reported.append($0) }
+        
+        progress.complete(.script)
+        progress.advance(.visuals, by: 0.5)
+        progress.complete(.voiceover)
+        progress.update(.visuals, fraction: 0.25)
+        progress.advance(.visuals, by: 0.5)
+        progress.complete(.mux)
+        progress.update(.encode, fraction: 0.5)
+        progress.complete(.encode)
+        
+        XCTAssertEqual(reported.count, 7, "A fraction lower than the stage's current one is not reported")
+        XCTAssertEqual(reported, reported.sorted(), "Overall progress should never go backwards")
+        XCTAssertEqual(reported[1], 0.1 + 0.35 * 0.5, accuracy: 0.0001)
+        XCTAssertEqual(reported.last, 1.0)
+    }
+    
     // MARK: - Voice Generation Tests
     func testVoiceOverGeneration() async throws {
         testExpectation = expectation(description: "Voice generation completed")
@@ -138,6 +157,25 @@ class MediaProcessorTests: XCTestCase {
         await waitForExpectations(timeout: 15.0)
     }
     
+    func testVoiceoverScriptChunksAtSentenceBoundariesWithoutLosingWords() {
+        let sentence = "The trade sends a rebuilding team two first round picks for a veteran guard."
+        let script = Array(repeating: sentence, count: 100).joined(separator: " ")
+        XCTAssertGreaterThan(script.count, 5000)
+        
+        let chunks = VoiceoverScript.chunks(of: script, maxLength: 500)
+        XCTAssertGreaterThan(chunks.count, 1)
+        XCTAssertTrue(chunks.allSatisfy { $0.count <= 500 })
+        XCTAssertTrue(chunks.allSatisfy { $0.hasPrefix("The trade") && $0.hasSuffix("guard.") })
+        XCTAssertEqual(chunks.joined(separator: " "), script)
+        
+        // A run-on sentence falls back to word boundaries
+        let runOn = Array(repeating: "pick", count: 300).joined(separator: " ")
+        let words = VoiceoverScript.chunks(of: runOn, maxLength: 100)
+        XCTAssertTrue(words.allSatisfy { $0.count <= 100 && !$0.hasSuffix(" ") })
+        XCTAssertEqual(words.joined(separator: " "), runOn)
+        XCTAssertTrue(VoiceoverScript.chunks(of: "  \n ").isEmpty)
+    }
+    
     // MARK: - Media Processing Tests
     func testMediaProcessing() async throws {
         testExpectation = expectation(description: "Media processing completed")
@@ -179,6 +217,173 @@ class MediaProcessorTests: XCTestCase {
         await waitForExpectations(timeout: 20.0)
     }
     
+    func testEncodeSettingsPreferHardwareAndKeepBitrateWithinFileSizeBudget() {
+        func capabilities(hardware: Bool, thermalState: ProcessInfo.ThermalState) -> DeviceCapabilities {
+            return DeviceCapabilities(processorCount: 6,
+                                      physicalMemory: 4_000_000_000,
+                                      thermalState: thermalState,
+                                      isLowPowerModeEnabled: false,
+                                      supportsHardwareEncoding: hardware,
+                                      supportsHEVCEncoding: hardware)
+        }
+        
+        let cool = VideoEncodeSettings.select(for: TEST_MEDIA_OPTIONS,
+                                              duration: 180,
+                                              capabilities: capabilities(hardware: true, thermalState: .nominal))
+        XCTAssertEqual(cool.encoder, .hevcVideoToolbox)
+        guard case .targetBitrate(let bitrate) = cool.rateControl else {
+            return XCTFail("Hardware encodes should always target a bitrate")
+        }
+        let projectedBytes = Double(bitrate + 128_000) * 180 / 8
+        XCTAssertLessThanOrEqual(projectedBytes, Double(TEST_MEDIA_OPTIONS.maxFileSize))
+        
+        let hot = VideoEncodeSettings.select(for: TEST_MEDIA_OPTIONS,
+                                             duration: 180,
+                                             capabilities: capabilities(hardware: true, thermalState: .serious))
+        XCTAssertEqual(hot.encoder, .h264VideoToolbox, "HEVC is skipped without thermal headroom")
+        
+        let simulator = VideoEncodeSettings.select(for: TEST_MEDIA_OPTIONS,
+                                                   duration: 180,
+                                                   capabilities: capabilities(hardware: false, thermalState: .serious))
+        XCTAssertEqual(simulator.encoder, .x264)
+        XCTAssertEqual(simulator.rateControl, .constantQuality(crf: 22))
+        XCTAssertEqual(simulator.preset, "veryfast", "Slow presets are not used on a hot device")
+    }
+    
+    func testJobSchedulerQueuesBeyondLimitAndDropsCancelledWaiters() async throws {
+        let scheduler = MediaJobScheduler(limit: 1)
+        let registry = MediaOperationRegistry()
+        var releaseFirst: CheckedContinuation<Void, Never>?
+        
+        let first = Task {
+            try await scheduler.run {
+                await withCheckedContinuation { releaseFirst = $0 }
+            }
+        }
+        while releaseFirst == nil {
+            await Task.yield()
+        }
+        
+        let queued = Task {
+            await registry.run("queued_encode") {
+                (try? await scheduler.run { true }) ?? false
+            }
+        }
+        while scheduler.queuedCount == 0 {
+            await Task.yield()
+        }
+        
+        XCTAssertTrue(registry.cancel("queued_encode"))
+        let ranWhileQueued = await queued.value
+        XCTAssertFalse(ranWhileQueued, "A job cancelled while queued should never run")
+        XCTAssertEqual(scheduler.queuedCount, 0)
+        XCTAssertFalse(registry.cancel("queued_encode"), "Finished operations leave the registry")
+        
+        releaseFirst?.resume()
+        try await first.value
+        let ranAfterRelease = try await scheduler.run { true }
+        XCTAssertTrue(ranAfterRelease, "The slot should be free again once the first job finishes")
+    }
+    
+    // MARK: - Media Cache Tests
+    func testMediaCacheReusesIdenticalInputsAndEvictsOverBudget() throws {
+        let directory = FileManager.default.temporaryDirectory.appendingPathComponent(UUID().uuidString)
+        defer { try? FileManager.default.removeItem(at: directory) }
+        let registry = TemporaryFileRegistry(directory: directory.appendingPathComponent("Operations"))
+        let cache = try XCTUnwrap(MediaCache(directory: directory.appendingPathComponent("Media"),
+                                             byteLimit: 1_500,
+                                             registry: registry))
+        let scope = registry.makeScope()
+        
+        func producedFile(bytes: Int) throws -> URL {
+            let url = FileManager.default.temporaryDirectory
+                .appendingPathComponent(UUID().uuidString)
+                .appendingPathExtension("mp3")
+            try Data(repeating: 7, count: bytes).write(to: url)
+            return url
+        }
+        
+        let key = MediaCache.voiceoverKey(text: TEST_VOICE_TEXT, quality: .premium, voiceID: "voice")
+        XCTAssertEqual(key, MediaCache.voiceoverKey(text: TEST_VOICE_TEXT, quality: .premium, voiceID: "voice"))
+        XCTAssertNotEqual(key, MediaCache.voiceoverKey(text: TEST_VOICE_TEXT, quality: .standard, voiceID: "voice"))
+        XCTAssertEqual(MediaCache.segmentKey(template: "player_intro", parameters: ["name": "A", "team": "KC"]),
+                       MediaCache.segmentKey(template: "player_intro", parameters: ["team": "KC", "name": "A"]),
+                       "Segment keys should not depend on dictionary order")
+        
+        XCTAssertNil(cache.url(forKey: key, fileExtension: "mp3"))
+        let producedURL = try producedFile(bytes: 1_000)
+        XCTAssertEqual(cache.store(producedURL, forKey: key), producedURL, "The producer keeps its own path")
+        let hitURL = try XCTUnwrap(TemporaryFileScope.$current.withValue(scope) {
+            cache.url(forKey: key, fileExtension: "mp3")
+        })
+        XCTAssertNotEqual(hitURL, producedURL)
+        XCTAssertTrue(registry.isInUse(hitURL), "Hits are linked into the reading operation's scope")
+        
+        let otherKey = MediaCache.voiceoverKey(text: "Player intro", quality: .premium, voiceID: "voice")
+        cache.store(try producedFile(bytes: 1_000), forKey: otherKey)
+        XCTAssertNil(cache.url(forKey: key, fileExtension: "mp3"), "Least recently used file should be evicted")
+        XCTAssertEqual(try Data(contentsOf: hitURL).count, 1_000, "Eviction must not delete a file still being read")
+        XCTAssertLessThanOrEqual(cache.totalBytes, 1_500)
+        scope.close()
+    }
+    
+    func testMediaCacheProducesConcurrentRequestsForOneKeyOnce() async throws {
+        let directory = FileManager.default.temporaryDirectory.appendingPathComponent(UUID().uuidString)
+        defer { try? FileManager.default.removeItem(at: directory) }
+        let registry = TemporaryFileRegistry(directory: directory.appendingPathComponent("Operations"))
+        let cache = try XCTUnwrap(MediaCache(directory: directory.appendingPathComponent("Media"),
+                                             byteLimit: 10_000,
+                                             registry: registry))
+        let key = MediaCache.voiceoverKey(text: TEST_VOICE_TEXT, quality: .premium, voiceID: "voice")
+        let produceCount = ProduceCounter()
+        
+        let urls = try await withThrowingTaskGroup(of: URL.self) { group -> [URL] in
+            for _ in 0..<8 {
+                group.addTask {
+                    try await cache.cachedOrProduce(key, fileExtension: "mp3") {
+                        produceCount.increment()
+                        try await Task.sleep(nanoseconds: 50_000_000)
+                        let url = registry.makeURL(pathExtension: "mp3")
+                        try Data(repeating: 3, count: 500).write(to: url)
+                        return url
+                    }
+                }
+            }
+            return try await group.reduce(into: []) { $0.append($1) }
+        }
+        
+        XCTAssertEqual(produceCount.value, 1, "Waiters should be served the first caller's file")
+        XCTAssertEqual(Set(urls).count, urls.count, "Every caller gets a path of its own")
+        XCTAssertTrue(urls.allSatisfy { (try? Data(contentsOf: $0).count) == 500 })
+    }
+    
+    func testTemporaryFilesAreDeletedOnlyOnceNoScopeHoldsThem() throws {
+        let directory = FileManager.default.temporaryDirectory.appendingPathComponent(UUID().uuidString)
+        defer { try? FileManager.default.removeItem(at: directory) }
+        let registry = TemporaryFileRegistry(directory: directory)
+        
+        let producer = registry.makeScope()
+        let consumer = registry.makeScope()
+        let sharedURL = TemporaryFileScope.$current.withValue(producer) { registry.makeURL(pathExtension: "mp4") }
+        let keptURL = TemporaryFileScope.$current.withValue(producer) { registry.makeURL(pathExtension: "mp4") }
+        try Data(repeating: 1, count: 64).write(to: sharedURL)
+        try Data(repeating: 2, count: 64).write(to: keptURL)
+        
+        XCTAssertTrue(consumer.retain(sharedURL))
+        XCTAssertFalse(consumer.retain(URL(fileURLWithPath: "/tmp/caller_input.mp4")), "Unmanaged files are never held")
+        producer.keep(keptURL)
+        producer.close()
+        XCTAssertTrue(registry.isInUse(sharedURL), "The consumer still holds the shared file")
+        XCTAssertTrue(FileManager.default.fileExists(atPath: sharedURL.path))
+        
+        consumer.close()
+        let deleted = expectation(for: NSPredicate { _, _ in
+            !FileManager.default.fileExists(atPath: sharedURL.path)
+        }, evaluatedWith: nil)
+        wait(for: [deleted], timeout: 2.0)
+        XCTAssertTrue(FileManager.default.fileExists(atPath: keptURL.path), "Kept files belong to the caller")
+    }
+    
     // MARK: - Resource Management Tests
     func testResourceManagement() async throws {
         testExpectation = expectation(description: "Resource management test completed")
@@ -222,4 +427,23 @@ class MediaProcessorTests: XCTestCase {
         testExpectation.fulfill()
         await waitForExpectations(timeout: 45.0)
     }
-}
\ No newline at end of file
+}
+
+// MARK: - Test Helpers
+/// Counts producer calls made from concurrent child tasks
+private final class ProduceCounter {
+    private let lock = NSLock()
+    private var count = 0
+    
+    var value: Int {
+        lock.lock()
+        defer { lock.unlock() }
+        return count
+    }
+    
+    func increment() {
+        lock.lock()
+        count += 1
+        lock.unlock()
+    }
+}
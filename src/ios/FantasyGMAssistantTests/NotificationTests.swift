@@ -213,6 +213,38 @@ final class NotificationTests: XCTestCase {
         
         await waitForExpectations(timeout: 5.0)
     }
+    
+    func testNotificationBatchMergesDuplicateAlertsAndKeepsLatest() {
+        func content(_ category: String, _ userInfo: [String: Any], badge: Int? = nil) -> UNNotificationContent {
+            let content = UNMutableNotificationContent()
+            content.categoryIdentifier = category
+            content.userInfo = userInfo
+            content.badge = badge.map { NSNumber(value: $0) }
+            return content
+        }
+        
+        var batch = NotificationBatch()
+        XCTAssertTrue(batch.isEmpty)
+        for week in 1...10 {
+            batch.append(content("INJURY_ALERT", ["player": "K.Murray", "week": week], badge: week),
+                         identifier: UUID().uuidString)
+        }
+        batch.append(content("GAME_START", ["game_id": "ARI-SF"]), identifier: UUID().uuidString)
+        batch.append(content("INJURY_ALERT", ["player": "J.Conner"]), identifier: UUID().uuidString)
+        batch.append(content("GAME_START", ["game_id": "ARI-SF"]), identifier: UUID().uuidString)
+        // Without an identifying field pushes are never merged
+        batch.append(content("TRADE_PROPOSAL", [:]), identifier: UUID().uuidString)
+        batch.append(content("TRADE_PROPOSAL", [:]), identifier: UUID().uuidString)
+        
+        XCTAssertEqual(batch.received, 15)
+        XCTAssertEqual(batch.categoryCounts, ["INJURY_ALERT": 11, "GAME_START": 2, "TRADE_PROPOSAL": 2])
+        XCTAssertEqual(batch.alerts.map { $0.categoryIdentifier },
+                       ["INJURY_ALERT", "GAME_START", "INJURY_ALERT", "TRADE_PROPOSAL", "TRADE_PROPOSAL"])
+        XCTAssertEqual(batch.alerts.map { $0.count }, [10, 2, 1, 1, 1])
+        XCTAssertEqual(batch.alerts[0].content.userInfo["week"] as? Int, 10, "Merged alerts keep the newest payload")
+        XCTAssertEqual(batch.badge, 10)
+        XCTAssertEqual(batch.summary, "15 pushes as 5 alerts (GAME_START: 2, INJURY_ALERT: 11, TRADE_PROPOSAL: 2)")
+    }
 }
 
 // MARK: - Mock Notification Center
@@ -8,6 +8,7 @@
 
 import XCTest // iOS 14.0+
 import Foundation // iOS 14.0+
+import UIKit // iOS 14.0+
 import MetricKit // iOS 14.0+
 @testable import FantasyGMAssistant
 
@@ -197,4 +198,204 @@ final class PerformanceTests: XCTestCase {
         // Clean up
         computeArray.removeAll()
     }
-}
\ No newline at end of file
+    
+    func testMemoryPressureTrimsLowPriorityFirst() {
+        let trimExpectation = XCTestExpectation(description: "Participants trimmed")
+        trimExpectation.expectedFulfillmentCount = 2
+        let cold = MockPressureParticipant(expectation: trimExpectation)
+        let warm = MockPressureParticipant(expectation: trimExpectation)
+        let hot = MockPressureParticipant(expectation: nil)
+        
+        MemoryPressureCoordinator.shared.register(cold, name: "cold", priority: .low)
+        MemoryPressureCoordinator.shared.register(warm, name: "warm", priority: .normal)
+        MemoryPressureCoordinator.shared.register(hot, name: "hot", priority: .high)
+        MemoryPressureCoordinator.shared.trim(for: .warning)
+        
+        wait(for: [trimExpectation], timeout: 5.0)
+        XCTAssertEqual(cold.trimmedFraction, 0.5, "Low priority caches should shed the most")
+        XCTAssertEqual(warm.trimmedFraction, 0.25, "Normal priority caches should be trimmed partially")
+        XCTAssertNil(hot.trimmedFraction, "High priority caches should survive a warning")
+    }
+    
+    func testSampleBufferOverwritesOldestAndExportsColumnsInOrder() {
+        let buffer = PerformanceSampleBuffer(capacity: 4)
+        for index in 0..<6 {
+            buffer.append(PerformanceSample(timestamp: TimeInterval(index),
+                                            memoryUsage: Float(index) / 10,
+                                            cpuUsage: Float(index * 10),
+                                            frameRate: 60,
+                                            thermalState: UInt8(index % 4)))
+        }
+        
+        XCTAssertEqual(buffer.count, 4)
+        XCTAssertEqual(buffer[0].timestamp, 2, "The two oldest samples should have been overwritten")
+        XCTAssertEqual(buffer.latest?.cpuUsage, 50)
+        
+        let data = buffer.exportBinary()
+        XCTAssertEqual(data.count, 16 + 4 * 21)
+        let header = (0..<4).map { field -> UInt32 in
+            data.subdata(in: (field * 4)..<(field * 4 + 4)).withUnsafeBytes { $0.load(as: UInt32.self) }
+        }
+        XCTAssertEqual(Array(header[1...]), [1, 4, 5])
+        let timestamps = (0..<4).map { index -> Double in
+            data.subdata(in: (16 + index * 8)..<(24 + index * 8)).withUnsafeBytes { $0.load(as: Double.self) }
+        }
+        XCTAssertEqual(timestamps, [2, 3, 4, 5])
+        XCTAssertEqual(Array(data.suffix(4)), [2, 3, 0, 1], "Thermal states should follow in recording order")
+    }
+    
+    func testLatencySketchQuantilesStayWithinRelativeAccuracyAndMerge() {
+        var single = LatencySketch()
+        single.record(0.25)
+        XCTAssertEqual(single.quantile(0.95) ?? 0, 0.25, accuracy: 0.0001, "One timing must not index out of range")
+        
+        let timings = (1...10_000).map { Double($0) / 1000 }
+        var first = LatencySketch()
+        var second = LatencySketch()
+        for (index, timing) in timings.shuffled().enumerated() {
+            if index % 2 == 0 { first.record(timing) } else { second.record(timing) }
+        }
+        
+        // Rebuilt from its upload form, as another session would receive it
+        guard let uploaded = LatencySketch(dictionary: second.dictionaryRepresentation) else {
+            return XCTFail("Sketch should round-trip through its dictionary representation")
+        }
+        XCTAssertTrue(first.merge(uploaded))
+        XCTAssertEqual(first.count, 10_000)
+        XCTAssertEqual(first.max, 10)
+        
+        for q in [0.5, 0.95, 0.99] {
+            let exact = timings[Int(q * Double(timings.count - 1))]
+            let estimate = first.quantile(q) ?? 0
+            XCTAssertLessThanOrEqual(abs(estimate - exact) / exact, 0.0101, "p\(Int(q * 100)) outside 1% accuracy")
+        }
+        XCTAssertFalse(first.merge(LatencySketch(relativeAccuracy: 0.05)), "Incompatible sketches must not merge")
+    }
+    
+    func testFrameTrackerCountsDroppedFramesAndAttributesHitchesToScreenAndSpan() {
+        let tracker = FrameHitchTracker()
+        let interval = 1.0 / 60
+        tracker.setActiveScreen("Lineup")
+        for _ in 0..<57 {
+            tracker.recordFrame(duration: interval, expected: interval)
+        }
+        
+        tracker.setActiveScreen("Trade")
+        tracker.beginSpan("run_simulation")
+        tracker.recordFrame(duration: interval * 4, expected: interval)
+        tracker.endSpan("run_simulation")
+        tracker.recordFrame(duration: 5.0, expected: interval)
+        
+        let pacing = tracker.dictionaryRepresentation
+        XCTAssertEqual(pacing["frames"] as? UInt64, 58, "Suspension-length gaps should be ignored")
+        XCTAssertEqual(pacing["dropped_frames"] as? UInt64, 3)
+        XCTAssertEqual(pacing["dropped_frame_ratio"] as? Double ?? 0, 3.0 / 61, accuracy: 0.0001)
+        
+        let screens = pacing["screens"] as? [String: [String: Any]]
+        XCTAssertEqual(screens?["Lineup"]?["hitches"] as? UInt64, 0)
+        XCTAssertEqual(screens?["Trade"]?["hitches"] as? UInt64, 1)
+        let spans = pacing["spans"] as? [String: [String: Any]]
+        XCTAssertEqual(spans?["run_simulation"]?["dropped_frames"] as? UInt64, 3)
+        XCTAssertNotNil(tracker.frameRate)
+    }
+    
+    func testTracerNestsSpansAndExportsInBatches() async throws {
+        var exported: [[String: Any]] = []
+        let tracer = PerformanceTracer(log: .disabled) { exported.append($0) }
+        
+        try await tracer.trace("outer") {
+            let inner = tracer.begin("inner")
+            tracer.end(inner)
+            _ = try? await tracer.trace("failing") { throw MediaError.processingFailed }
+        }
+        let bridgeSpan = tracer.beginBridgeSpan("lineup_render", parentID: nil)
+        XCTAssertTrue(tracer.endBridgeSpan(bridgeSpan, failed: false))
+        XCTAssertFalse(tracer.endBridgeSpan(bridgeSpan, failed: false), "A span should only end once")
+        
+        let spans = tracer.pendingSpans
+        XCTAssertEqual(spans.map { $0.name }, ["inner", "failing", "outer", "lineup_render"])
+        let outerID = spans[2].id
+        XCTAssertEqual(spans[0].parentID, outerID)
+        XCTAssertEqual(spans[1].parentID, outerID)
+        XCTAssertTrue(spans[1].failed)
+        XCTAssertNil(spans[2].parentID)
+        XCTAssertTrue(exported.isEmpty, "Spans should be buffered until a batch is due")
+        
+        for _ in 0..<96 {
+            tracer.end(tracer.begin("tick"))
+        }
+        XCTAssertEqual(exported.count, 1)
+        XCTAssertEqual(exported.first?["span_count"] as? Int, 100)
+        XCTAssertTrue(tracer.pendingSpans.isEmpty)
+        
+        tracer.end(tracer.begin("tick"))
+        NotificationCenter.default.post(name: UIApplication.didEnterBackgroundNotification, object: nil)
+        XCTAssertEqual(exported.count, 2, "Entering the background should export a partial batch")
+        XCTAssertTrue(tracer.pendingSpans.isEmpty)
+    }
+    
+    func testProfileMonitorPublishesChangesAndModulesScaleToLevel() {
+        let cool = PerformanceProfile(deviceClass: .high, thermalState: .nominal, isLowPowerModeEnabled: false)
+        let saving = PerformanceProfile(deviceClass: .high, thermalState: .fair, isLowPowerModeEnabled: true)
+        let critical = PerformanceProfile(deviceClass: .high, thermalState: .critical, isLowPowerModeEnabled: false)
+        XCTAssertEqual([cool.level, saving.level, critical.level], [.full, .reduced, .minimal])
+        let hotLowEnd = PerformanceProfile(deviceClass: .low, thermalState: .serious, isLowPowerModeEnabled: false)
+        XCTAssertEqual(hotLowEnd.level, .minimal)
+        
+        XCTAssertGreaterThan(CacheManager.memoryCostLimit(for: cool), CacheManager.memoryCostLimit(for: saving))
+        XCTAssertGreaterThan(AnalyticsManager.maxBatchAge(for: critical), AnalyticsManager.maxBatchAge(for: cool))
+        XCTAssertNil(VideoEncodeSettings.maxHeight(for: cool))
+        XCTAssertEqual(MediaJobScheduler.encodeLimit(for: saving), 1)
+        
+        let monitor = PerformanceProfileMonitor(deviceClass: .high)
+        let observer = MockProfileObserver()
+        observer.expectation = expectation(description: "Registration and one change delivered")
+        observer.expectation?.expectedFulfillmentCount = 2
+        monitor.register(observer)
+        monitor.publish(saving)
+        monitor.publish(saving)
+        
+        wait(for: [observer.expectation!], timeout: 2.0)
+        XCTAssertEqual(observer.received.last, saving, "Unchanged profiles should not be republished")
+    }
+    
+    func testActivityTrackerReportsDenseSamplingUntilLastActivityEnds() {
+        let changes = expectation(forNotification: PerformanceActivity.didChangeNotification, object: nil)
+        changes.expectedFulfillmentCount = 2
+        
+        PerformanceActivity.shared.begin(.simulation)
+        PerformanceActivity.shared.begin(.videoRender)
+        PerformanceActivity.shared.end(.simulation)
+        XCTAssertTrue(PerformanceActivity.shared.isActive)
+        PerformanceActivity.shared.end(.videoRender)
+        PerformanceActivity.shared.end(.videoRender)
+        XCTAssertFalse(PerformanceActivity.shared.isActive)
+        
+        wait(for: [changes], timeout: 1.0)
+    }
+}
+
+// MARK: - Test Helpers
+private final class MockProfileObserver: PerformanceProfileObserver {
+    var expectation: XCTestExpectation?
+    private(set) var received: [PerformanceProfile] = []
+    
+    func performanceProfileDidChange(_ profile: PerformanceProfile) {
+        received.append(profile)
+        expectation?.fulfill()
+    }
+}
+
+private final class MockPressureParticipant: MemoryPressureParticipant {
+    private let expectation: XCTestExpectation?
+    private(set) var trimmedFraction: Double?
+    
+    init(expectation: XCTestExpectation?) {
+        self.expectation = expectation
+    }
+    
+    func trimMemory(fraction: Double, level: MemoryPressureLevel) {
+        trimmedFraction = fraction
+        expectation?.fulfill()
+    }
+}